@@ -21,6 +21,10 @@
 # include <BALL/DATATYPE/hashMap.h>
 #endif
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
 #include <vector>
 #include <math.h>
 
@@ -39,6 +43,16 @@ namespace BALL
 			Contour surfaces are created from 3D (volume) data sets, in general from 
 			data sets store in \link RegularData3D RegularData3D \endlink using a 
 			marching cube algorithm.
+			\par
+			The grid may be processed by several threads (see \link setNumberOfThreads 
+			setNumberOfThreads \endlink). In this case, the grid is split into slabs of 
+			consecutive xy-planes which are triangulated independently. The partial meshes
+			are joined in slab order, vertices on the planes shared by two slabs are merged.
+			The resulting surface is identical to the one computed by a single thread.
+			\par
+			For grids whose surface would not fit into memory, \link streamTriangles 
+			streamTriangles \endlink passes the triangles slab by slab to a callback instead
+			of storing them.
     	\ingroup  DatatypeMiscellaneous
   */
   template <typename T>  
@@ -64,6 +78,21 @@ namespace BALL
 				This type is used to store the edge points of the contour-Surface.
 		*/
 		typedef std::vector<std::pair<PointType, std::pair<Position, Position> > > VectorType;
+
+		/** Callback interface for streaming triangle extraction.
+				Derived classes receive the three vertices of each triangle in the
+				order in which they would have been inserted into the surface.
+				The triangle normal is given by <tt>(v1 - v2) % (v3 - v2)</tt>.
+		*/
+		class TriangleCallback
+		{
+			public:
+
+			virtual ~TriangleCallback() {}
+
+			/// Called once per triangle.
+			virtual void operator () (const Vector3& v1, const Vector3& v2, const Vector3& v3) = 0;
+		};
 		//@}
 
 		/** @name Constructors and Destructors.
@@ -100,6 +129,43 @@ namespace BALL
 		virtual void clear();
 		//@}
 
+		/** @name Accessors
+		 */
+		//@{
+
+		/** Set the number of threads used to triangulate the grid.
+				Values smaller than one are treated as one.
+		*/
+		void setNumberOfThreads(Size number_of_threads) { number_of_threads_ = std::max((Size)1, number_of_threads); }
+
+		/// Return the number of threads used to triangulate the grid
+		Size getNumberOfThreads() const { return number_of_threads_; }
+
+		/** Set the number of xy-planes per slab used by \link streamTriangles streamTriangles \endlink.
+				The memory required for streaming is proportional to the slab size
+				times the number of threads. Values smaller than one are treated as one.
+		*/
+		void setSlabSize(Size slab_size) { slab_size_ = std::max((Size)1, slab_size); }
+
+		/// Return the number of xy-planes per slab used for streaming
+		Size getSlabSize() const { return slab_size_; }
+		//@}
+
+		/** @name Streaming
+		 */
+		//@{
+
+		/** Compute the contour surface of a data set without storing it.
+				The grid is processed in slabs of \link getSlabSize getSlabSize \endlink
+				planes, up to \link getNumberOfThreads getNumberOfThreads \endlink slabs at 
+				a time. The triangles of each slab are passed to <tt>callback</tt> in slab order
+				from the calling thread, so the callback need not be thread-safe.
+				The surface stored in this instance is not modified.
+				@return the number of triangles passed to the callback
+		*/
+		Size streamTriangles(const TRegularData3D<T>& data, TriangleCallback& callback) const;
+		//@}
+
 		/** @name Predicates
 		 */
 		//@{
@@ -234,17 +300,41 @@ namespace BALL
 		};
 
 
+		/** The partial surface of a slab of the grid.
+				Vertex indices in triangle refer to vertex. For each vertex, key
+				contains the grid indices of the edge the vertex lies on.
+		*/
+		struct Slab
+		{
+			std::vector<Vector3>			vertex;
+			std::vector<KeyType>			key;
+			std::vector<Triangle>			triangle;
+			HashMap<KeyType, Position>	cut_hash_map;
+		};
+
+		/// Triangulate the cubes whose lower z index lies in [z_begin, z_end)
+		void computeSlab_(const TRegularData3D<T>* data, const FacetArray* facet_data,
+											Position z_begin, Position z_end, Slab* slab) const;
+
+		/// Triangulate a number of consecutive slabs, one thread per slab
+		void computeSlabs_(const TRegularData3D<T>& data, const FacetArray& facet_data,
+											 const std::vector<Position>& bounds, std::vector<Slab>& slabs) const;
+
 		/// 
-		void addTriangles_(Cube& cube, const FacetArray& facet_data);
+		void addTriangles_(Cube& cube, const FacetArray& facet_data, Slab& slab) const;
 
-		///
-		void computeTriangles(Size topology, const TRegularData3D<T>& data);
+		/// Append a slab to the surface, merging the vertices shared with the previous slab
+		void appendSlab_(const Slab& slab, const Slab* previous, Position plane_begin, Position plane_end,
+										 const std::vector<Position>& previous_indices, std::vector<Position>& indices);
 
 		/// The threshold separating inside and outside
 		T threshold_;
 
-		//
-		HashMap<std::pair<Position, Position>, Position> cut_hash_map_;
+		/// The number of threads
+		Size number_of_threads_;
+
+		/// The number of xy-planes per slab for streaming
+		Size slab_size_;
 	};
 
 	/// Default type
@@ -252,19 +342,25 @@ namespace BALL
 
 	template <typename T>
 	TContourSurface<T>::TContourSurface()
-		: threshold_(0.0)
+		: threshold_(0.0),
+			number_of_threads_(1),
+			slab_size_(16)
 	{
 	}
 
 	template <typename T>
 	TContourSurface<T>::TContourSurface(T threshold)
-		: threshold_(threshold)
+		: threshold_(threshold),
+			number_of_threads_(1),
+			slab_size_(16)
 	{
 	}
    
 	template <typename T>
 	TContourSurface<T>::TContourSurface(const TRegularData3D<T>& data, T threshold)
-		: threshold_(threshold)
+		: threshold_(threshold),
+			number_of_threads_(1),
+			slab_size_(16)
 	{
 		this->operator << (data);
 	}
@@ -276,7 +372,9 @@ namespace BALL
 
 	template <typename T>
 	TContourSurface<T>::TContourSurface(const TContourSurface<T>& from)
-		: threshold_(from.threshold_)
+		: threshold_(from.threshold_),
+			number_of_threads_(from.number_of_threads_),
+			slab_size_(from.slab_size_)
 	{
   }
 
@@ -284,7 +382,6 @@ namespace BALL
 	void TContourSurface<T>::clear()
 	{
 		Surface::clear();
-		cut_hash_map_.clear();
 	}
 
 	template <typename T>
@@ -294,6 +391,8 @@ namespace BALL
 		if (&data != this)
 		{
 			threshold_ = data.threshold_;
+			number_of_threads_ = data.number_of_threads_;
+			slab_size_ = data.slab_size_;
 		}
 
 		return *this;
@@ -312,23 +411,140 @@ namespace BALL
 		// Clear the old stuff:
 		clear();
 		
-		
 		// Marching cube algorithm: construct a contour surface from
 		// a volume data set.
 
 		// Get the dimensions of the volume data set.
-		Vector3 origin = data.getOrigin();
 		Size number_of_cells_x = (Size)data.getSize().x;
 		Size number_of_cells_y = (Size)data.getSize().y;
 		Size number_of_cells_z = (Size)data.getSize().z;
+		if ((number_of_cells_x < 2) || (number_of_cells_y < 2) || (number_of_cells_z < 2))
+		{
+			return *this;
+		}
 
 		// Precompute the facet data. This depends on the threshold!
 		const FacetArray& facet_data = getContourSurfaceFacetData(threshold_);
 
-		// We start in the left-front-bottom-most corner of the grid.
+		// Split the grid into one slab of xy-planes per thread.
+		Size number_of_slabs = std::min(number_of_threads_, number_of_cells_z - 1);
+		std::vector<Position> bounds(number_of_slabs + 1);
+		for (Position i = 0; i <= number_of_slabs; ++i)
+		{
+			bounds[i] = (Position)((i * (number_of_cells_z - 1)) / number_of_slabs);
+		}
+
+		std::vector<Slab> slabs(number_of_slabs);
+		computeSlabs_(data, facet_data, bounds, slabs);
+
+		// Join the slabs in z order. This yields the same vertex 
+		// and triangle order as a single pass over the grid.
+		Size plane_size = number_of_cells_x * number_of_cells_y;
+		std::vector<Position> previous_indices;
+		std::vector<Position> indices;
+		for (Position i = 0; i < number_of_slabs; ++i)
+		{
+			const Slab* previous = (i == 0) ? 0 : &slabs[i - 1];
+			appendSlab_(slabs[i], previous, bounds[i] * plane_size, (bounds[i] + 1) * plane_size, 
+			            previous_indices, indices);
+			if (previous != 0)
+			{
+				slabs[i - 1] = Slab();
+			}
+			previous_indices.swap(indices);
+		}
+
+		// Normalize the vertex normals.
+		for (Position i = 0; i < normal.size(); i++)
+		{
+			try
+			{
+				normal[i].normalize();
+			}
+			catch (...)
+			{
+			}
+		}
+
+		// Return this (stream operator, for command chaining...)
+		return *this;
+	}
+
+	template <typename T>
+	Size TContourSurface<T>::streamTriangles
+		(const TRegularData3D<T>& data, typename TContourSurface<T>::TriangleCallback& callback) const
+	{
+		Size number_of_cells_z = (Size)data.getSize().z;
+		if ((data.getSize().x < 2) || (data.getSize().y < 2) || (number_of_cells_z < 2))
+		{
+			return 0;
+		}
+
+		const FacetArray& facet_data = getContourSurfaceFacetData(threshold_);
+
+		// Process up to number_of_threads_ slabs at a time and
+		// hand their triangles to the callback in order.
+		Size number_of_triangles = 0;
+		Position z = 0;
+		while (z < number_of_cells_z - 1)
+		{
+			std::vector<Position> bounds(1, z);
+			while ((bounds.size() <= number_of_threads_) && (z < number_of_cells_z - 1))
+			{
+				z = std::min((Position)(z + slab_size_), (Position)(number_of_cells_z - 1));
+				bounds.push_back(z);
+			}
+
+			std::vector<Slab> slabs(bounds.size() - 1);
+			computeSlabs_(data, facet_data, bounds, slabs);
+
+			for (Position i = 0; i < slabs.size(); ++i)
+			{
+				const std::vector<Vector3>& v = slabs[i].vertex;
+				for (Position j = 0; j < slabs[i].triangle.size(); ++j)
+				{
+					const Triangle& t = slabs[i].triangle[j];
+					callback(v[t.v1], v[t.v2], v[t.v3]);
+				}
+				number_of_triangles += slabs[i].triangle.size();
+			}
+		}
+
+		return number_of_triangles;
+	}
+
+	template <typename T>
+	void TContourSurface<T>::computeSlabs_
+		(const TRegularData3D<T>& data, const FacetArray& facet_data,
+		 const std::vector<Position>& bounds, std::vector<Slab>& slabs) const
+	{
+		if (slabs.size() == 1)
+		{
+			computeSlab_(&data, &facet_data, bounds[0], bounds[1], &slabs[0]);
+			return;
+		}
+
+		boost::thread_group threads;
+		for (Position i = 0; i < slabs.size(); ++i)
+		{
+			threads.create_thread(boost::bind(&TContourSurface<T>::computeSlab_, this, 
+			                                  &data, &facet_data, bounds[i], bounds[i + 1], &slabs[i]));
+		}
+		threads.join_all();
+	}
+
+	template <typename T>
+	void TContourSurface<T>::computeSlab_
+		(const TRegularData3D<T>* data, const FacetArray* facet_data,
+		 Position z_begin, Position z_end, typename TContourSurface<T>::Slab* slab) const
+	{
+		Size number_of_cells_x = (Size)data->getSize().x;
+		Size number_of_cells_y = (Size)data->getSize().y;
+
+		// We start in the left-front-bottom-most corner of the slab.
 		Position current_index = 0;
-		Cube cube(data);
-		for (Position curr_cell_z = 0; curr_cell_z < (number_of_cells_z - 1); curr_cell_z++)
+		Cube cube(*data);
+		for (Position curr_cell_z = z_begin; curr_cell_z < z_end; curr_cell_z++)
 		{ 
 			// Determine the start position in the current XY plane.
 			current_index = curr_cell_z * number_of_cells_y * number_of_cells_x;
@@ -343,8 +559,8 @@ namespace BALL
 				// Walk along the x-axis....
 				for (Position curr_cell_x = 0; (curr_cell_x < (number_of_cells_x - 2)); )
 				{
-					// Compute topology, triangles, and add those triangles to the surface.
-					addTriangles_(cube, facet_data);
+					// Compute topology, triangles, and add those triangles to the slab.
+					addTriangles_(cube, *facet_data, *slab);
 						
 					// Done. cube.shift() will now shift the cube
 					// along the x-axis and efficently retrieve the four new values.
@@ -353,40 +569,68 @@ namespace BALL
 				}
 
 				// Add the triangles from the last cube position.
-				addTriangles_(cube, facet_data);
+				addTriangles_(cube, *facet_data, *slab);
 	
 				// Shift the cube by one along the y-axis.
 				current_index += number_of_cells_x;
 			}
 		}
+	}
 
-		// Normalize the vertex normals.
-		for (Position i = 0; i < normal.size(); i++)
+	template <typename T>
+	void TContourSurface<T>::appendSlab_
+		(const typename TContourSurface<T>::Slab& slab, const typename TContourSurface<T>::Slab* previous,
+		 Position plane_begin, Position plane_end,
+		 const std::vector<Position>& previous_indices, std::vector<Position>& indices)
+	{
+		static const Vector3 null_normal(0.0, 0.0, 0.0);
+
+		// Map the slab's vertices to surface vertices. Cuts on edges within the 
+		// lowest plane of the slab have already been created by the previous slab.
+		indices.resize(slab.vertex.size());
+		for (Position i = 0; i < slab.vertex.size(); ++i)
 		{
-			try
+			const KeyType& key = slab.key[i];
+			if ((previous != 0) && (key.first >= plane_begin) && (key.second < plane_end) 
+					&& previous->cut_hash_map.has(key))
 			{
-				normal[i].normalize();
+				indices[i] = previous_indices[previous->cut_hash_map[key]];
 			}
-			catch (...)
+			else
 			{
+				indices[i] = (Position)vertex.size();
+				vertex.push_back(slab.vertex[i]);
+				normal.push_back(null_normal);
 			}
 		}
 
-		// Return this (stream operator, for command chaining...)
-		return *this;
+		for (Position i = 0; i < slab.triangle.size(); ++i)
+		{
+			Triangle t;
+			t.v1 = indices[slab.triangle[i].v1];
+			t.v2 = indices[slab.triangle[i].v2];
+			t.v3 = indices[slab.triangle[i].v3];
+			triangle.push_back(t);
+
+			// Compute the normals: add the triangle
+			// normals to each of the triangle vertices.
+			// We will average them out to the correct normals later.
+			Vector3 h1(vertex[t.v1] - vertex[t.v2]);
+			Vector3 h2(vertex[t.v3] - vertex[t.v2]);
+			Vector3 current_normal(h1.y * h2.z - h1.z * h2.y,
+														 h1.z * h2.x - h2.z * h1.x,
+														 h1.x * h2.y - h1.y * h2.x);
+			normal[t.v1] += current_normal;
+			normal[t.v2] += current_normal;
+			normal[t.v3] += current_normal;
+		}
 	}
 
 	template <typename T>
 	void TContourSurface<T>::addTriangles_
-		(typename TContourSurface<T>::Cube& cube, const FacetArray& facet_data)
+		(typename TContourSurface<T>::Cube& cube, const FacetArray& facet_data, 
+		 typename TContourSurface<T>::Slab& slab) const
 	{ 
-		// Some static variables we need below -- since we will
-		// call this rather often, we would rather want to avoid
-		// to many ctor/dtor calls.
-		static Triangle t;
-		static std::pair<Position, Position> key;
-		static std::pair<Position, Position> indices;
-
 		// The indices of the corners of a cube's twelve edges.
 		static const Position edge_indices[12][2] 
 			= {{1, 0}, {1, 2}, {2, 3}, {0, 3}, {5, 4}, {5, 6},
@@ -398,23 +642,26 @@ namespace BALL
 		static const Position edge_axis[12] 
 			= {2, 0, 2, 0, 2, 0, 2, 0, 1, 1, 1, 1};
 
+		// Compute the cube's topology
+		Position topology = cube.computeTopology(threshold_);
+		if (topology == 0)
+		{
+			return;
+		}
+
 		// Retrieve some basic grid properties.
 		const Vector3& spacing = cube.getSpacing();
 
-		// The indices (into Surface::vertex) of the triangle
+		// The indices (into slab.vertex) of the triangle
 		// under construction.
 		TVector3<Position> triangle_vertices;
 
 		// A counter for the number of vertices already in triangle_vertices
 		Size vertex_counter = 0;
-		
-		// Compute the cube's topology
-		Position topology = cube.computeTopology(threshold_);
-		if (topology == 0)
-		{
-			return;
-		}
 
+		std::pair<Position, Position> key;
+		std::pair<Position, Position> indices;
+		
 		// Iterate over all 12 edges and determine whether
 		// there's a cut. 
 		for (Position i = 0; i < 12; i++) 
@@ -437,7 +684,8 @@ namespace BALL
 				key.second = cube.getIndex(indices.second);
 
 				// Check whether we computed this cut already.
-				if (!cut_hash_map_.has(key))
+				typename HashMap<KeyType, Position>::Iterator it = slab.cut_hash_map.find(key);
+				if (it == slab.cut_hash_map.end())
 				{
 					// Compute the position of the cut.
 					
@@ -450,46 +698,33 @@ namespace BALL
 					pos[edge] += ((double)threshold_ - d1) / (d2 - d1) * spacing[edge];
 					
 					// Store it as a triangle vertex.
-					triangle_vertices[vertex_counter++] = vertex.size();
+					triangle_vertices[vertex_counter++] = slab.vertex.size();
 
 					// Store the index of the vertex in the hash map under the
 					// indices of its grid points.
-					cut_hash_map_.insert(std::pair<std::pair<Position, Position>, Position>(key, (Size)vertex.size()));
+					slab.cut_hash_map.insert(std::pair<KeyType, Position>(key, (Size)slab.vertex.size()));
 
-					// Create a vertex and a normal (the normal reamins empty for now).
-					vertex.push_back(pos);
-					static Vector3 null_normal(0.0, 0.0, 0.0);
-					normal.push_back(null_normal);
+					// Create the vertex.
+					slab.vertex.push_back(pos);
+					slab.key.push_back(key);
 				}
 				else
 				{
 					// This one we know already! Retrieve it from the hash map.
-					triangle_vertices[vertex_counter++] = cut_hash_map_[key];
+					triangle_vertices[vertex_counter++] = it->second;
 				}
 				
 				// For every three vertices, create a new triangle.
 				if (vertex_counter == 3)
 				{
-					// Create a new triangle.
+					Triangle t;
 					t.v1 = triangle_vertices.x;
 					t.v2 = triangle_vertices.y;
 					t.v3 = triangle_vertices.z;
-					triangle.push_back(t);
+					slab.triangle.push_back(t);
 
 					// We can start with the next one.
 					vertex_counter = 0;
-
-					// Compute the normals: add the triangle
-					// normals to each of the triangle vertices.
-					// We will average them out to the correct normals later.
-					Vector3 h1(vertex[t.v1] - vertex[t.v2]);
-					Vector3 h2(vertex[t.v3] - vertex[t.v2]);
-					Vector3 current_normal(h1.y * h2.z - h1.z * h2.y,
-																 h1.z * h2.x - h2.z * h1.x,
-																 h1.x * h2.y - h1.y * h2.x);
-					normal[t.v1] += current_normal;
-					normal[t.v2] += current_normal;
-					normal[t.v3] += current_normal;
 				}
 			}
 		}
@@ -0,0 +1,212 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_DOCKING_COMMON_PAIRWISERMSDMATRIX_H
+#define BALL_DOCKING_COMMON_PAIRWISERMSDMATRIX_H
+
+#ifndef BALL_MOLMEC_COMMON_FLATVECTOR_H
+# include <BALL/MOLMEC/COMMON/flatVector.h>
+#endif
+
+#ifndef BALL_MATHS_VECTOR3_H
+# include <BALL/MATHS/vector3.h>
+#endif
+
+#ifndef BALL_DATATYPE_STRING_H
+# include <BALL/DATATYPE/string.h>
+#endif
+
+#include <vector>
+
+namespace boost
+{
+	namespace iostreams
+	{
+		class mapped_file;
+	}
+}
+
+namespace BALL
+{
+	/** \brief Pairwise RMSD matrix of many poses of the same structure.
+
+			The coordinates of the selected atoms of all poses are packed into
+			one aligned float matrix (poses x atoms x 3). The RMSD between two
+			poses is computed without superposition (the poses are assumed to be
+			mapped onto each other already, as in PoseClustering), with a
+			unit-stride squared distance kernel the compiler can vectorize.
+			\par
+			The full matrix is stored in condensed form, i.e. only the upper
+			triangle without the diagonal, row by row: n (n - 1) / 2 floats for
+			n poses. It is computed in square tiles of  \link TILE_SIZE TILE_SIZE \endlink
+			poses, so that the coordinates of two tiles stay in the cache, and the
+			tiles are distributed over several threads. For very large pose sets,
+			the condensed matrix can be written into a memory mapped file instead
+			of main memory.
+			\par
+			Methods that only need single rows of the matrix (e.g. SLINK and CLINK)
+			can use  \link computeRow computeRow \endlink, which requires no
+			storage beyond the coordinates.
+
+			\ingroup DockingMiscellaneous
+	 */
+	class BALL_EXPORT PairwiseRMSDMatrix
+	{
+		public:
+
+			/// The number of poses per tile
+			static const Size TILE_SIZE;
+
+			/**	@name Constructors and Destructor
+			*/
+			//@{
+
+			/// Default constructor
+			PairwiseRMSDMatrix();
+
+			/// Destructor, unmaps the matrix file if necessary
+			virtual ~PairwiseRMSDMatrix();
+
+			//@}
+			/**	@name Coordinates
+			*/
+			//@{
+
+			/** Allocate the coordinate matrix.
+					The coordinates are set to zero, a previously computed matrix is discarded.
+			*/
+			void setSize(Size number_of_poses, Size number_of_atoms);
+
+			/** Copy the positions of all atoms of pose i.
+					@return false if the number of positions does not match
+			*/
+			bool setPose(Position i, const std::vector<Vector3>& positions);
+
+			/** Copy the positions of the selected atoms of pose i.
+					@param selection the indices of the selected atoms in <tt>positions</tt>
+					@return false if the number of selected atoms does not match
+			*/
+			bool setPose(Position i, const std::vector<Vector3>& positions, const std::vector<Position>& selection);
+
+			/// Return the number of poses
+			Size getNumberOfPoses() const { return number_of_poses_; }
+
+			/// Return the number of atoms per pose
+			Size getNumberOfAtoms() const { return number_of_atoms_; }
+
+			/// Return the packed coordinates of pose i (3 * number_of_atoms floats)
+			const float* getCoordinates(Position i) const { return coordinates_.getData() + (LongSize)i * stride_; }
+
+			//@}
+			/**	@name Computation
+			*/
+			//@{
+
+			/// Set the number of threads (at least one)
+			void setNumberOfThreads(Size number_of_threads) { number_of_threads_ = std::max((Size)1, number_of_threads); }
+
+			/// Return the number of threads
+			Size getNumberOfThreads() const { return number_of_threads_; }
+
+			/// Compute the RMSD between pose i and pose j from the coordinates
+			float computeRMSD(Position i, Position j) const;
+
+			/** Compute the RMSDs between pose i and the poses <tt>0, ..., number - 1</tt>.
+					Long rows are split over the threads.
+					@param result an array of at least <tt>number</tt> floats
+			*/
+			void computeRow(Position i, Size number, float* result) const;
+
+			/** Compute the condensed matrix in main memory.
+			*/
+			void compute();
+
+			/** Compute the condensed matrix into a memory mapped file.
+					The file is created or overwritten, it contains the raw floats of
+					the condensed matrix and stays mapped until the next call of
+					\link setSize setSize \endlink or the destructor.
+					@return false if the file could not be created or mapped
+			*/
+			bool compute(const String& filename);
+
+			/// Return true if the matrix has been computed
+			bool isComputed() const { return computed_; }
+
+			/// Return true if the matrix is stored in a memory mapped file
+			bool isMemoryMapped() const { return mapped_file_ != 0; }
+
+			/** Return the RMSD between pose i and pose j from the computed matrix.
+			*/
+			float operator () (Position i, Position j) const
+			{
+				if (i == j)
+				{
+					return 0.0f;
+				}
+				return (i < j) ? values_[getCondensedIndex(i, j)] : values_[getCondensedIndex(j, i)];
+			}
+
+			/// Return the condensed matrix, 0 if it has not been computed or is empty
+			const float* getCondensedMatrix() const { return values_; }
+
+			/// Return the number of entries of the condensed matrix
+			LongSize getCondensedSize() const { return (LongSize)number_of_poses_ * (number_of_poses_ - (number_of_poses_ > 0)) / 2; }
+
+			/// Return the index of the pair (i, j), i < j, in the condensed matrix
+			LongSize getCondensedIndex(Position i, Position j) const
+			{
+				return (LongSize)i * number_of_poses_ - (LongSize)i * (i + 1) / 2 + (j - i - 1);
+			}
+
+			//@}
+
+		protected:
+
+			//_ Compute all tiles with index congruent to first modulo step
+			void computeTiles_(Size first, Size step);
+
+			//_ Compute the matrix into values_ with all threads
+			void computeMatrix_();
+
+			//_ Compute the RMSDs of pose i to the poses begin, ..., end - 1
+			void computeRowRange_(Position i, Position begin, Position end, float* result) const;
+
+			//_ Discard the computed matrix
+			void clearMatrix_();
+
+			//_ The number of poses
+			Size number_of_poses_;
+
+			//_ The number of atoms per pose
+			Size number_of_atoms_;
+
+			//_ The distance of two poses in the coordinate matrix (in floats)
+			Size stride_;
+
+			//_ The packed coordinates of all poses
+			FlatVector::Array coordinates_;
+
+			//_ The number of threads
+			Size number_of_threads_;
+
+			//_ The condensed matrix in main memory
+			std::vector<float> matrix_;
+
+			//_ The memory mapped condensed matrix
+			boost::iostreams::mapped_file* mapped_file_;
+
+			//_ The condensed matrix (either in matrix_ or in mapped_file_)
+			float* values_;
+
+			//_ True if the matrix has been computed
+			bool computed_;
+
+		private:
+
+			PairwiseRMSDMatrix(const PairwiseRMSDMatrix&);
+			PairwiseRMSDMatrix& operator = (const PairwiseRMSDMatrix&);
+	};
+}
+
+#endif // BALL_DOCKING_COMMON_PAIRWISERMSDMATRIX_H
@@ -56,6 +56,8 @@
 
 namespace BALL
 {
+	class PairwiseRMSDMatrix;
+
 	/** Pose Clustering 
 	    \ingroup DockingMiscellaneous
 	 */
@@ -85,6 +87,14 @@ namespace BALL
 			 - SLINK_SIBSON as described in 
 			            R. Sibson: SLINK: an optimally efficient algorithm for the single-link cluster method. 
                   The Computer Journal. 16, 1, British Computer Society, 1973, p. 30-34
+			 - SPHERE_EXCLUSION: an approximate leader clustering for very large pose sets.
+			      In input order, each pose joins the nearest leader closer than DISTANCE_THRESHOLD, 
+			      or becomes a new leader. Then, each pose is moved to its nearest leader.
+			      Candidate leaders are found by a grid over the centers of mass of the selected atoms; 
+			      since their distance is a lower bound of the RMSD, most RMSD computations are skipped.
+			      Time is close to linear for small thresholds and memory is linear in the number
+			      of poses plus the coordinates of the leaders. The cluster scores are the cluster radii.
+			      Only SNAPSHOT_RMSD and CENTER_OF_MASS_DISTANCE are supported.
 
 		  
 		  The scope of the scoring (the atoms to be considered) can be defined via the option RMSD_LEVEL_OF_DETAIL.
@@ -177,7 +187,8 @@ namespace BALL
 				SLINK_SIBSON,
 				CLINK_DEFAYS,
 				NEAREST_NEIGHBOR_CHAIN_WARD,
-				CLINK_ALTHAUS
+				CLINK_ALTHAUS,
+				SPHERE_EXCLUSION
 			};
 
 			class BALL_EXPORT RigidTransformation
@@ -582,6 +593,11 @@ namespace BALL
 			//
 			bool althausCompute_();
 
+			// implementation of a leader (sphere exclusion) clustering: in input order, each
+			// pose joins the nearest leader within DISTANCE_THRESHOLD or becomes a leader itself;
+			// afterwards, all poses are moved to their nearest leader
+			bool sphereExclusionCompute_();
+
 			//	implementation of a single linkage clustering as described in 
 			//       R. Sibson: SLINK: an optimally efficient algorithm for the single-link cluster method. 
 			//       The Computer Journal. 16, 1, British Computer Society, 1973, p. 30-34
@@ -627,6 +643,14 @@ namespace BALL
 			// compute the RMSD between two "poses"  
 			float getRMSD_(Index i, Index j, Index rmsd_type);
 
+			// the indices of the atoms of the atom bijection in the snapshots;
+			// returns false if the bijection or the snapshots do not allow this
+			bool computeSelectedAtomIndices_(std::vector<Position>& selection);
+
+			// pack the snapshot coordinates of the selected atoms into the matrix;
+			// returns false if the rmsd type or the poses do not allow this
+			bool setupRMSDMatrix_(PairwiseRMSDMatrix& matrix);
+
 			// store pointers to the snapshots in the poses vector
 			void storeSnapShotReferences_();
 
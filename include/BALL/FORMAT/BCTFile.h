@@ -0,0 +1,202 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_FORMAT_BCTFILE_H
+#define BALL_FORMAT_BCTFILE_H
+
+#ifndef BALL_FORMAT_TRAJECTORYFILE_H
+#	include <BALL/FORMAT/trajectoryFile.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	/** BCT compressed trajectory file format.
+			A lossy, compressed trajectory format in the spirit of the GROMACS XTC
+			format. Only the atom positions and the energies of each SnapShot are
+			stored, velocities and forces are discarded.
+			\par
+			The coordinates are quantized to multiples of <tt>1 / precision</tt>
+			Angstrom (default: 1000, i.e. 0.001 Angstrom). Each frame stores integer
+			differences, either to the previous atom of the same frame (key frames)
+			or to the same atom in the previous frame (delta frames), whichever is
+			smaller. The differences are zig-zag encoded and packed as variable
+			length integers, i.e. small differences need a single byte.
+			Every <tt>key_frame_interval</tt>-th frame is a key frame, so a frame
+			can be decoded by reading at most <tt>key_frame_interval</tt> frames.
+			\par
+			The file ends with an index of the frame offsets, which allows random
+			access with  \link seekSnapShot seekSnapShot \endlink.
+			If the index is missing (e.g. the writing process was killed), it is
+			rebuilt from the frame sizes when the file is opened.
+			\par
+			All numbers are stored in little endian byte order, so the format is portable.
+			\par
+			Layout of the file:
+			\code
+				header:   "BCTF" version number_of_atoms number_of_snapshots precision key_frame_interval index_offset
+				frame:    size type potential_energy kinetic_energy packed_differences
+				...
+				index:    number_of_snapshots offset_0 ... offset_n-1
+			\endcode
+
+    	\ingroup  MDFormats
+	*/
+	class BALL_EXPORT BCTFile
+		:	public TrajectoryFile
+	{
+		public:
+
+		/** @name Constants
+		*/
+		//@{
+
+		/// The version of the format written by this class
+		static const Size VERSION;
+
+		/// The default precision (quantization steps per Angstrom)
+		static const double DEFAULT_PRECISION;
+
+		/// The default distance of key frames
+		static const Size DEFAULT_KEY_FRAME_INTERVAL;
+
+		//@}
+		/** @name Constructors and Destructor
+		*/
+		//@{
+
+		/// Default constructor
+		BCTFile();
+
+		/** Detailed constructor.
+				In write mode, the file is truncated and a header is written.
+				In read mode, the header and the frame index are read.
+				@throw Exception::FileNotFound if the file could not be openend
+		*/
+		BCTFile(const String& name, File::OpenMode open_mode = std::ios::in);
+
+		/// Destructor, writes the frame index if necessary
+		virtual ~BCTFile();
+
+		//@}
+		/** @name Assignment
+		*/
+		//@{
+
+		/// Clear method
+		virtual void clear();
+
+		//@}
+		/** @name Predicates
+		*/
+		//@{
+
+		/// Equality operator
+		bool operator == (const BCTFile& file) const;
+
+		//@}
+		/** @name Accessors
+		*/
+		//@{
+
+		/** Set the precision, i.e. the number of quantization steps per Angstrom.
+				This has to be called before the first frame is written.
+				@return false if frames have already been written or the precision is not positive
+		*/
+		bool setPrecision(double precision);
+
+		/// Return the precision (quantization steps per Angstrom)
+		double getPrecision() const;
+
+		/** Set the distance of key frames.
+				This has to be called before the first frame is written.
+				@return false if frames have already been written
+		*/
+		bool setKeyFrameInterval(Size interval);
+
+		/// Return the distance of key frames
+		Size getKeyFrameInterval() const;
+
+		//@}
+		/// @name Public methods for file handling
+		//@{
+
+		/** Read the header and the frame index of an existing file.
+				The next call of  \link read read \endlink returns the first frame.
+				@return true if the header could be read successfully, false ow.
+		*/
+		virtual bool readHeader();
+
+		/** Write the header.
+				@return true if the header could be written successfully, false ow.
+		*/
+		virtual bool writeHeader();
+
+		/** Append a SnapShot.
+				The header and the frame index are updated by
+				\link flushToDisk flushToDisk \endlink or the destructor.
+				@return false if the number of atoms differs from the previous frames
+		*/
+		virtual bool append(const SnapShot& snapshot);
+
+		/** Read the next SnapShot.
+				@return true if a SnapShot could be read, false ow.
+		*/
+		virtual bool read(SnapShot& snapshot);
+
+		/** Position the file such that the next call of  \link read read \endlink
+				returns the SnapShot with the given (zero-based) number.
+				@return false if there is no such SnapShot
+		*/
+		virtual bool seekSnapShot(Position number);
+
+		/** Append several SnapShots and update the header and the frame index.
+				@throw File::CannotWrite if the file is not opened for writing
+		*/
+		virtual bool flushToDisk(const std::vector<SnapShot>& buffer);
+
+		//@}
+
+		private:
+			const BCTFile& operator = (const BCTFile& file);
+
+		protected:
+
+		//_ Write the frame index and the header
+		bool writeIndex_();
+
+		//_ Rebuild the frame index from the frame sizes
+		bool scanFrames_();
+
+		//_ Read and decode the next frame into quantized_
+		bool readFrame_(double* potential_energy, double* kinetic_energy);
+
+		//_ The number of quantization steps per Angstrom
+		double precision_;
+
+		//_ The distance of key frames
+		Size key_frame_interval_;
+
+		//_ The file offsets of all frames
+		std::vector<LongSize> frame_offsets_;
+
+		//_ The offset of the frame index, i.e. the end of the frame data
+		LongSize data_end_;
+
+		//_ The quantized coordinates of the last frame written or read
+		std::vector<Index> quantized_;
+
+		//_ A buffer for the encoded frames
+		std::vector<unsigned char> buffer_;
+
+		//_ The number of the next frame to be read
+		Position current_snapshot_;
+
+		//_ True if frames have been written since the last update of the index
+		bool index_dirty_;
+	};
+} // namespace BALL
+
+#endif // BALL_FORMAT_BCTFILE_H
@@ -13,6 +13,14 @@
 # include <BALL/SYSTEM/binaryFileAdaptor.h>
 #endif
 
+namespace boost
+{
+	namespace iostreams
+	{
+		class mapped_file_source;
+	}
+}
+
 namespace BALL
 {
 	/** DCD Trajectory file format. This class enables BALL to write DCD
@@ -85,6 +93,9 @@ namespace BALL
 		 */
 		virtual bool open(const String& name, File::OpenMode open_mode = std::ios::in);
 
+		/// Close the file and unmap it
+		void close();
+
 		/** Initialize this instance, i. e. read the header and update members
 		*/
 		bool init();
@@ -118,6 +129,21 @@ namespace BALL
 		*/
 		virtual bool read(SnapShot& snapshot);
 
+		/** Position the file such that the next call of  \link read read \endlink
+				returns the SnapShot with the given (zero-based) number.
+				All frames of a DCD file have the same size, so the file offset of
+				a frame is computed from the size of the first frame.
+				@return false if there is no such SnapShot
+		*/
+		virtual bool seekSnapShot(Position number);
+
+		/** Read only the atom positions of the SnapShot with the given (zero-based) number.
+				If the file is memory mapped, the coordinates are copied directly from
+				the mapped file into <tt>positions</tt>, without touching the stream.
+				@return true if the positions could be read, false ow.
+		*/
+		virtual bool readAtomPositions(Position number, std::vector<Vector3>& positions);
+
 		/** @copydoc TrajectoryFile::flushToDisk(const std::vector<SnapShot>&)
 		 */
 		virtual bool flushToDisk(const std::vector<SnapShot>& buffer);
@@ -133,6 +159,19 @@ namespace BALL
 		/// 
 		void disableVelocityStorage();
 
+		/** Map the file read-only into memory for  \link readAtomPositions readAtomPositions \endlink.
+				Frames appended after the mapping was created are read from the stream.
+				The mapping is dropped by  \link open open \endlink,  \link close close \endlink and  \link clear clear \endlink.
+				@return false if the file could not be mapped
+		*/
+		bool enableMemoryMapping();
+
+		/// Unmap the file
+		void disableMemoryMapping();
+
+		/// Return true if the file is memory mapped
+		bool isMemoryMapped() const;
+
 		//@}
 
 		private:
@@ -163,6 +202,12 @@ namespace BALL
 		//_
 		bool readVector_(vector<Vector3>& v);
 
+		/*_ Determine the size of a frame by reading the first frame.
+				The stream position, the stream state and the current snapshot are
+				restored afterwards.
+		*/
+		bool computeFrameSize_();
+
 		//_
 		Size verbosity_;
 
@@ -200,6 +245,15 @@ namespace BALL
 		*/
 		Position current_snapshot_;
 
+		//_ The file offset of the first frame, i.e. the size of the header
+		LongSize first_frame_offset_;
+
+		//_ The size of a frame in bytes, 0 if not yet known
+		LongSize frame_size_;
+
+		//_ The memory mapped file, if any
+		boost::iostreams::mapped_file_source* mapped_file_;
+
 		BinaryFileAdaptor<Size>  adapt_size_;
 		BinaryFileAdaptor<float> adapt_float_;
 	};
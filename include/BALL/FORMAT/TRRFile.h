@@ -228,6 +228,16 @@ namespace BALL
 		*/
 		virtual bool skipFrame();
 
+		/** Position the file such that the next call of  \link read read \endlink
+				returns the SnapShot with the given (zero-based) number.
+				The file offsets of all frames are recorded when the frames are
+				counted, i.e. on the first call of this method or of
+				 \link getNumberOfSnapShots getNumberOfSnapShots \endlink,
+				and whenever the file has grown since.
+				@return false if there is no such SnapShot
+		*/
+		virtual bool seekSnapShot(Position number);
+
 		/** get the number of snapshots stored in this instance.
 				@return the number of snapshots of this instance
 		*/
@@ -317,6 +327,9 @@ namespace BALL
 		BinaryFileAdaptor<double> adapt_double_;
 
 		Size old_file_size_;
+
+		// the file offsets of all frames
+		std::vector<LongSize> frame_offsets_;
 	};
 } // namespace BALL
 
@@ -105,6 +105,34 @@ namespace BALL
 		*/
 		virtual bool read(SnapShot& snapshot);
 
+		/** Position the file such that the next call of  \link read read \endlink
+				returns the SnapShot with the given (zero-based) number.
+				The default implementation reopens the file, rereads the header and
+				skips the preceding SnapShots. Formats with a frame index or fixed
+				frame sizes override this method with constant time random access.
+				@param number the number of the SnapShot
+				@return true if there is such a SnapShot, false ow.
+		*/
+		virtual bool seekSnapShot(Position number);
+
+		/** Read the SnapShot with the given (zero-based) number.
+				This is a shortcut for  \link seekSnapShot seekSnapShot \endlink
+				followed by  \link read read \endlink.
+				@param number the number of the SnapShot
+				@param snapshot a buffer for result delivery
+				@return true if the SnapShot could be read, false ow.
+		*/
+		bool readSnapShot(Position number, SnapShot& snapshot);
+
+		/** Read only the atom positions of the SnapShot with the given (zero-based) number.
+				Formats storing velocities or forces may override this method to skip
+				these data, or to copy the positions directly from a memory mapped file.
+				@param number the number of the SnapShot
+				@param positions a buffer for result delivery
+				@return true if the positions could be read, false ow.
+		*/
+		virtual bool readAtomPositions(Position number, std::vector<Vector3>& positions);
+
 		/** Write several SnapShots to disk.
 		 *	@param buffer a vector of snapshots
 		 *	@return true, if flushing was successful, false ow.
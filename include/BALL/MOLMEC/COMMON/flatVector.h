@@ -0,0 +1,253 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_MOLMEC_COMMON_FLATVECTOR_H
+#define BALL_MOLMEC_COMMON_FLATVECTOR_H
+
+#ifndef BALL_COMMON_H
+#	include <BALL/common.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace BALL
+{
+	/**	Kernels for flat float arrays.
+			The minimizers store gradients, directions and update vectors as 3N
+			consecutive floats (a Gradient or a <tt>std::vector<Vector3></tt> has
+			exactly this layout). The functions in this namespace operate on such
+			arrays with simple unit-stride loops that the compiler can vectorize.
+			The dot products use several independent partial sums, so the
+			reduction does not serialize on a single accumulator.
+			\par
+
+    	\ingroup  MolmecCommon
+	*/
+	namespace FlatVector
+	{
+		/**	Dot product with double accumulation.
+				The products are computed in float and summed up in double precision.
+				This is the variant used by the minimizers, since the curvature
+				values of quasi-Newton updates are sensitive to cancellation.
+		*/
+		inline double dot(const float* x, const float* y, Size n)
+		{
+			double s0 = 0.0;
+			double s1 = 0.0;
+			double s2 = 0.0;
+			double s3 = 0.0;
+
+			Size i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				s0 += (double)(x[i] * y[i]);
+				s1 += (double)(x[i + 1] * y[i + 1]);
+				s2 += (double)(x[i + 2] * y[i + 2]);
+				s3 += (double)(x[i + 3] * y[i + 3]);
+			}
+			for (; i < n; ++i)
+			{
+				s0 += (double)(x[i] * y[i]);
+			}
+
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		/**	Dot product with float accumulation.
+				Faster than  \link dot dot \endlink, but less accurate for long vectors.
+		*/
+		inline float dotFloat(const float* x, const float* y, Size n)
+		{
+			float s0 = 0.0f;
+			float s1 = 0.0f;
+			float s2 = 0.0f;
+			float s3 = 0.0f;
+
+			Size i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				s0 += x[i] * y[i];
+				s1 += x[i + 1] * y[i + 1];
+				s2 += x[i + 2] * y[i + 2];
+				s3 += x[i + 3] * y[i + 3];
+			}
+			for (; i < n; ++i)
+			{
+				s0 += x[i] * y[i];
+			}
+
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		/**	Squared euclidean distance of two arrays.
+				The squared differences are summed up in float in blocks of 256
+				elements with several partial sums, and the block sums are
+				accumulated in double precision. This vectorizes like  \link dotFloat dotFloat \endlink, but keeps
+				the rounding error of long arrays close to that of
+				 \link dot dot \endlink.
+		*/
+		inline double squaredDistance(const float* x, const float* y, Size n)
+		{
+			const Size BLOCK_SIZE = 256;
+
+			double sum = 0.0;
+			Size i = 0;
+			while (i < n)
+			{
+				const Size end = std::min(n, i + BLOCK_SIZE);
+
+				float s0 = 0.0f;
+				float s1 = 0.0f;
+				float s2 = 0.0f;
+				float s3 = 0.0f;
+				for (; i + 4 <= end; i += 4)
+				{
+					const float d0 = x[i] - y[i];
+					const float d1 = x[i + 1] - y[i + 1];
+					const float d2 = x[i + 2] - y[i + 2];
+					const float d3 = x[i + 3] - y[i + 3];
+					s0 += d0 * d0;
+					s1 += d1 * d1;
+					s2 += d2 * d2;
+					s3 += d3 * d3;
+				}
+				for (; i < end; ++i)
+				{
+					const float d = x[i] - y[i];
+					s0 += d * d;
+				}
+
+				sum += (double)((s0 + s1) + (s2 + s3));
+			}
+
+			return sum;
+		}
+
+		/**	Scaled addition: <tt>y += alpha * x</tt>.
+		*/
+		inline void axpy(float alpha, const float* x, float* y, Size n)
+		{
+			for (Size i = 0; i < n; ++i)
+			{
+				y[i] += alpha * x[i];
+			}
+		}
+
+		/**	Scaling: <tt>x *= alpha</tt>.
+		*/
+		inline void scale(float alpha, float* x, Size n)
+		{
+			for (Size i = 0; i < n; ++i)
+			{
+				x[i] *= alpha;
+			}
+		}
+
+		/**	Difference: <tt>result = x - y</tt>.
+		*/
+		inline void subtract(const float* x, const float* y, float* result, Size n)
+		{
+			for (Size i = 0; i < n; ++i)
+			{
+				result[i] = x[i] - y[i];
+			}
+		}
+
+		/**	An aligned array of floats.
+				The first element is aligned to  \link ALIGNMENT ALIGNMENT \endlink bytes,
+				which allows full-width vector loads on all current SIMD extensions.
+				The array is used for the history of the limited memory minimizers,
+				where several vectors of 3N floats are stored one after another.
+				Resizing does not preserve the contents.
+		*/
+		class BALL_EXPORT Array
+		{
+			public:
+
+			/// The alignment of the first element in bytes
+			enum { ALIGNMENT = 64 };
+
+			/// Default constructor
+			Array()
+				:	buffer_(),
+					data_(0),
+					size_(0)
+			{
+			}
+
+			/// Construct an array of n zeros
+			explicit Array(LongSize n)
+				:	buffer_(),
+					data_(0),
+					size_(0)
+			{
+				resize(n);
+			}
+
+			/// Copy constructor
+			Array(const Array& array)
+				:	buffer_(),
+					data_(0),
+					size_(0)
+			{
+				*this = array;
+			}
+
+			/// Assignment operator
+			Array& operator = (const Array& array)
+			{
+				if (&array != this)
+				{
+					resize(array.size_);
+					for (LongSize i = 0; i < size_; ++i)
+					{
+						data_[i] = array.data_[i];
+					}
+				}
+				return *this;
+			}
+
+			/// Set the number of elements, all elements are set to zero
+			void resize(LongSize n)
+			{
+				const Size padding = ALIGNMENT / sizeof(float);
+				buffer_.assign(n + padding, 0.0f);
+				size_ = n;
+
+				PointerSizeUInt address = (PointerSizeUInt)&buffer_[0];
+				Size offset = (Size)(((ALIGNMENT - address % ALIGNMENT) % ALIGNMENT) / sizeof(float));
+				data_ = &buffer_[offset];
+			}
+
+			/// Return the number of elements
+			LongSize size() const { return size_; }
+
+			/// Return a pointer to the first element
+			float* getData() { return data_; }
+
+			/// Return a const pointer to the first element
+			const float* getData() const { return data_; }
+
+			/// Element access
+			float& operator [] (Position i) { return data_[i]; }
+
+			/// Const element access
+			const float& operator [] (Position i) const { return data_[i]; }
+
+			protected:
+
+			//_ The storage including the alignment padding
+			std::vector<float> buffer_;
+
+			//_ The aligned first element within buffer_
+			float* data_;
+
+			//_ The number of elements
+			LongSize size_;
+		};
+	}
+} // namespace BALL
+
+#endif // BALL_MOLMEC_COMMON_FLATVECTOR_H
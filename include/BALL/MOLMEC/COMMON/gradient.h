@@ -141,6 +141,18 @@ namespace BALL
 		const Vector3& operator [] (int i) const { return std::vector<Vector3>::operator [] (i); }
 		Vector3& operator [] (int i) { return std::vector<Vector3>::operator [] (i); }
 
+		/**	Return the components as a flat array.
+				The gradient is stored as <tt>3 * size()</tt> consecutive floats
+				(x, y, z of the first atom, x, y, z of the second atom, ...).
+				This allows the use of the kernels in  \link FlatVector FlatVector \endlink.
+				@return a pointer to the first float, 0 for an empty gradient
+		*/
+		float* getData() { return empty() ? 0 : &(std::vector<Vector3>::operator [] (0).x); }
+
+		/**	Return the components as a constant flat array.
+		*/
+		const float* getData() const { return empty() ? 0 : &(std::vector<Vector3>::operator [] (0).x); }
+
 		/**	Invalidate the gradient.
 		*/	
 		void invalidate();
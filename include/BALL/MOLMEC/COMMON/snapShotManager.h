@@ -19,6 +19,8 @@
 # include <BALL/SYSTEM/file.h>
 #endif
 
+#include <boost/thread/thread.hpp>
+
 namespace BALL
 {
 	class TrajectoryFile;
@@ -28,6 +30,13 @@ namespace BALL
 /**	Snapshot management e.g. for MD simulations.
 		This class manages a list of single SnapShot objects.
 		Snapshots are numbered starting with 1.	 \par
+		If  \link Option::ASYNCHRONOUS_OUTPUT asynchronous output \endlink is enabled,
+		the snapshots are written by a background thread: when the buffer is full,
+		it is swapped with a second buffer that is written while the simulation
+		continues and fills the first one. If the previous buffer has not been written
+		when the next one is full, the simulation waits. Thus, at most two buffers
+		are kept in memory. The destructor writes the remaining snapshots and waits
+		for the background thread.  \par
 		\ingroup  MolmecCommon
 */
 class BALL_EXPORT SnapShotManager
@@ -42,6 +51,12 @@ class BALL_EXPORT SnapShotManager
 				@param frequency integer
 		*/
 		static const char* FLUSH_TO_DISK_FREQUENCY;
+
+		/** Write the snapshots in a background thread
+				@see Default::ASYNCHRONOUS_OUTPUT
+				@param asynchronous_output bool
+		*/
+		static const char* ASYNCHRONOUS_OUTPUT;
 	};
 
 	/// Local class for handling default values for the options
@@ -52,6 +67,11 @@ class BALL_EXPORT SnapShotManager
 				@see Option::FLUSH_TO_DISK_FREQUENCY 
 		*/
 		static const Size FLUSH_TO_DISK_FREQUENCY;
+
+		/** By default, the snapshots are written by the calling thread.
+				@see Option::ASYNCHRONOUS_OUTPUT
+		*/
+		static const bool ASYNCHRONOUS_OUTPUT;
 	};
 
 
@@ -180,6 +200,25 @@ class BALL_EXPORT SnapShotManager
 	*/
 	Size getFlushToDiskFrequency() const;
 
+	/** Enable or disable writing the snapshots in a background thread.
+			Disabling waits for the snapshots that are currently being written.
+			@throw File::CannotWrite thrown if a previous background write failed
+	*/
+	void setAsynchronousOutput(bool state) throw(File::CannotWrite);
+
+	/// Return true if the snapshots are written in a background thread
+	bool isAsynchronousOutputEnabled() const;
+
+	/** Wait until the background thread has written all snapshots handed to it.
+			This does not write the snapshots still in the buffer, use
+			\link flushToDisk flushToDisk \endlink before if necessary.
+			A failed background write is reported once, by this method or by
+			\link flushToDisk flushToDisk \endlink, even if the manager was
+			cleared or set up again in between.
+			@throw File::CannotWrite thrown if the background write failed
+	*/
+	void waitForOutput() throw(File::CannotWrite);
+
 	/** This method takes a snapshot of the system's current state and stores
 			it in main memory. If there is not sufficient space, the snapshots
 			collected so far are flushed to hard disk. The first snapshot taken
@@ -189,7 +228,9 @@ class BALL_EXPORT SnapShotManager
 	virtual void takeSnapShot() throw(File::CannotWrite);
 
 	/** Read a certain SnapShot from a TrajectoryFile. This method tries to
-			read SnapShot number <b>number</b> from the file
+			read SnapShot number <b>number</b> from the file. Formats with random
+			access (e.g. DCD, TRR, BCT) read only the requested frame, see
+			 \link TrajectoryFile::seekSnapShot TrajectoryFile::seekSnapShot \endlink.
 			@param number the number of the snapshot we want to read
 			@param snapshot a buffer for returning the snapshot
 			@return true if the snapshot could be read, <b>false</b> ow.
@@ -216,8 +257,12 @@ class BALL_EXPORT SnapShotManager
 	*/
 	virtual bool applyLastSnapShot();
 
-	/// This method writes all snapshots taken so far to hard disk
-	/// @throw File::CannotWrite thrown if the snapshots could not be flushed to disk
+	/** This method writes all snapshots taken so far to hard disk.
+			With asynchronous output, the snapshots are handed to the background
+			thread and the method returns before they are written.
+			@throw File::CannotWrite thrown if the snapshots could not be flushed to disk,
+			       or if a previous background write failed
+	*/
 	virtual void flushToDisk() throw(File::CannotWrite);
 
 	///
@@ -269,6 +314,21 @@ class BALL_EXPORT SnapShotManager
 	//_ Number of the current SnapShot (used with buffer_)
 	Position current_snapshot_;
 
+	//_ Write the snapshots in a background thread
+	bool asynchronous_output_;
+
+	//_ The snapshots written by the background thread
+	vector<SnapShot> output_buffer_;
+
+	//_ The background thread, 0 if no write is in progress
+	boost::thread* output_thread_;
+
+	//_ Set by the background thread if writing failed, reset when waitForOutput() reports it
+	bool output_failed_;
+
+	//_ The name of the file written by the background thread
+	String output_file_name_;
+
 	//_@}
 	/*_ @name Protected methods
 	*/
@@ -278,6 +338,14 @@ class BALL_EXPORT SnapShotManager
 	*/
 	double calculateKineticEnergy_();
 
+	/*_ Write output_buffer_ to the trajectory file (run by the background thread)
+	*/
+	void writeOutputBuffer_();
+
+	/*_ Join the background thread, if any. A failed write is kept in output_failed_.
+	*/
+	void joinOutputThread_();
+
 	//_@}
 
 }; // end of class SnapshotManager 
@@ -63,6 +63,11 @@ namespace BALL
 			 */
 			virtual void updateForces();
 
+			/**
+			 * Return the bonds and their parameters.
+			 */
+			const std::vector<QuadraticBondStretch::Data>& getStretchData() const { return stretch_; }
+
 			//@} 
 
 		protected:
@@ -0,0 +1,244 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_MOLMEC_MDSIMULATION_CONSTRAINTSOLVER_H
+#define BALL_MOLMEC_MDSIMULATION_CONSTRAINTSOLVER_H
+
+#ifndef BALL_COMMON_H
+# include <BALL/common.h>
+#endif
+
+#ifndef BALL_MATHS_VECTOR3_H
+# include <BALL/MATHS/vector3.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	class Atom;
+	class AtomVector;
+	class ForceField;
+
+	/**	Holonomic constraints for molecular dynamics.
+			This class keeps the lengths of bonds to hydrogen atoms and the geometry
+			of rigid water molecules fixed during a Velocity Verlet integration.
+			Constraining the fastest motions of the system allows time steps
+			of 2 fs instead of 0.5 fs.
+			\par
+			Bonds containing hydrogen atoms are constrained with SHAKE (positions) and
+			RATTLE (velocities) to the equilibrium bond length of the force field's
+			stretch component. If the force field has no
+			\link StretchComponent StretchComponent \endlink, the bond lengths at the time
+			of the setup are used.
+			Water molecules (molecules consisting of one oxygen and two hydrogen atoms) are
+			treated as rigid bodies with the analytical SETTLE algorithm
+			(S. Miyamoto and P.A. Kollman, J. Comput. Chem. 13 (1992), 952-962).
+			The coordinates of all water molecules are gathered into separate arrays for
+			each coordinate so that SETTLE runs as a single loop without branches
+			over all water molecules.
+			\par
+			Atoms that are not part of the atom vector given to  \link setup setup \endlink
+			(e.g. unselected atoms) are treated as having infinite mass, i.e. they are never
+			moved by the constraints.
+			\par
+			Usage within an integration step:
+			\code
+				solver.storeReferencePositions();
+				// ...unconstrained position update x(t+dt) = x(t) + dt * v(t+dt/2)...
+				solver.constrainPositions(time_step);
+				// ...force evaluation and final velocity update...
+				solver.constrainVelocities(time_step);
+			\endcode
+
+			\ingroup  MDSimulation
+	*/
+	class BALL_EXPORT ConstraintSolver
+	{
+		public:
+
+		/**	@name	Constants
+		*/
+		//@{
+		/// The O-H distance of TIP3P water in Angstrom
+		static const double TIP3P_OH_DISTANCE;
+
+		/// The H-H distance of TIP3P water in Angstrom
+		static const double TIP3P_HH_DISTANCE;
+		//@}
+
+		/**	@name	Constructors and Destructors
+		*/
+		//@{
+
+		BALL_CREATE(ConstraintSolver)
+
+		/// Default constructor
+		ConstraintSolver();
+
+		/// Copy constructor
+		ConstraintSolver(const ConstraintSolver& solver);
+
+		/// Destructor
+		virtual ~ConstraintSolver();
+
+		/// Assignment operator
+		ConstraintSolver& operator = (const ConstraintSolver& solver);
+
+		/// Remove all constraints
+		void clear();
+		//@}
+
+		/**	@name	Setup
+		*/
+		//@{
+
+		/**	Determine the constraints for the atoms of a force field.
+				@param force_field the force field, used for the equilibrium bond lengths
+				@param atoms the atoms that are integrated
+				@param constrain_h_bonds constrain all bonds containing a hydrogen atom
+				@param rigid_water keep water molecules rigid with SETTLE
+				@return the number of constraints
+		*/
+		Size setup(const ForceField& force_field, const AtomVector& atoms, bool constrain_h_bonds, bool rigid_water);
+
+		/**	Set the geometry of rigid water molecules.
+				The default is the TIP3P geometry. Calling this method does not affect the
+				constraints determined by a previous  \link setup setup \endlink.
+		*/
+		void setWaterGeometry(double oh_distance, double hh_distance);
+
+		/// Set the relative tolerance of the iterative solvers (default: 1e-6)
+		void setTolerance(double tolerance) { tolerance_ = tolerance; }
+
+		/// Return the relative tolerance of the iterative solvers
+		double getTolerance() const { return tolerance_; }
+
+		/// Set the maximum number of SHAKE/RATTLE iterations (default: 500)
+		void setMaxNumberOfIterations(Size max_iterations) { max_iterations_ = max_iterations; }
+
+		/// Return the maximum number of SHAKE/RATTLE iterations
+		Size getMaxNumberOfIterations() const { return max_iterations_; }
+		//@}
+
+		/**	@name	Accessors
+		*/
+		//@{
+
+		/**	Return the number of constrained degrees of freedom.
+				Each constrained bond removes one, each rigid water molecule three
+				degrees of freedom.
+		*/
+		Size getNumberOfConstraints() const;
+
+		/// Return the number of constrained bonds (excluding rigid water molecules)
+		Size getNumberOfBondConstraints() const { return (Size)bond_atom1_.size(); }
+
+		/// Return the number of rigid water molecules
+		Size getNumberOfRigidWaters() const { return (Size)water_oxygen_.size(); }
+
+		/// Return true if there are no constraints
+		bool isEmpty() const { return bond_atom1_.empty() && water_oxygen_.empty(); }
+
+		/**	Return the largest relative deviation of a constrained distance.
+				This is <tt>|d - d0| / d0</tt> over all bond constraints and water distances.
+		*/
+		double getMaxDeviation() const;
+		//@}
+
+		/**	@name	Constraint solving
+		*/
+		//@{
+
+		/**	Store the current, constrained positions.
+				These positions are the reference for the next call of
+				\link constrainPositions constrainPositions \endlink.
+		*/
+		void storeReferencePositions();
+
+		/**	Project the atom positions back onto the constraints.
+				The reference positions have to be stored before the unconstrained update.
+				If <tt>time_step</tt> is positive, the velocities are corrected by the
+				displacement caused by the constraints divided by the time step.
+				@return false if SHAKE did not converge
+		*/
+		bool constrainPositions(double time_step);
+
+		/**	Remove the velocity components along the constraints (RATTLE).
+				@param time_step the time step, used for the convergence criterion
+				@return false if RATTLE did not converge
+		*/
+		bool constrainVelocities(double time_step);
+		//@}
+
+		protected:
+
+		//_ The atoms touched by a constraint
+		std::vector<Atom*> atoms_;
+
+		//_ The inverse masses of the atoms, 0 for atoms that are not integrated
+		std::vector<double> inverse_masses_;
+
+		//_ The reference positions stored by storeReferencePositions
+		std::vector<Vector3> reference_positions_;
+
+		//_ Temporary positions in single precision
+		std::vector<Vector3> positions_;
+
+		//_ Temporary positions/velocities in double precision
+		std::vector<double> work_x_;
+		std::vector<double> work_y_;
+		std::vector<double> work_z_;
+
+		//_ The first atom of each bond constraint (local index)
+		std::vector<Index> bond_atom1_;
+
+		//_ The second atom of each bond constraint (local index)
+		std::vector<Index> bond_atom2_;
+
+		//_ The squared constraint lengths
+		std::vector<double> bond_length2_;
+
+		//_ The oxygen atoms of the rigid water molecules (local index)
+		std::vector<Index> water_oxygen_;
+
+		//_ The first hydrogen atoms of the rigid water molecules (local index)
+		std::vector<Index> water_hydrogen1_;
+
+		//_ The second hydrogen atoms of the rigid water molecules (local index)
+		std::vector<Index> water_hydrogen2_;
+
+		//_ The mass of the water oxygen atoms
+		double water_oxygen_mass_;
+
+		//_ The mass of the water hydrogen atoms
+		double water_hydrogen_mass_;
+
+		//_ The coordinates of all water molecules, one array per coordinate (see settlePositions_)
+		std::vector<double> water_buffer_;
+
+		//_ The O-H distance of water
+		double water_oh_distance_;
+
+		//_ The H-H distance of water
+		double water_hh_distance_;
+
+		//_ The relative tolerance
+		double tolerance_;
+
+		//_ The maximum number of iterations
+		Size max_iterations_;
+
+		private:
+
+		//_ SETTLE for all rigid water molecules
+		void settlePositions_();
+
+		//_ Analytical velocity constraints for all rigid water molecules
+		void settleVelocities_();
+	};
+
+}	// namespace BALL
+
+#endif // BALL_MOLMEC_MDSIMULATION_CONSTRAINTSOLVER_H
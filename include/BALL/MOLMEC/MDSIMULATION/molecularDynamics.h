@@ -22,6 +22,10 @@
 # include <BALL/MOLMEC/COMMON/atomVector.h>
 #endif
 
+#ifndef BALL_MOLMEC_MDSIMULATION_CONSTRAINTSOLVER_H
+# include <BALL/MOLMEC/MDSIMULATION/constraintSolver.h>
+#endif
+
 #include <vector>
 
 namespace BALL
@@ -86,6 +90,24 @@ namespace BALL
 			/** The current time of the simulation in picoseconds
 			 */
 			static const char* CURRENT_TIME;
+
+			/** Constrain the lengths of all bonds containing hydrogen atoms
+					(SHAKE/RATTLE). This allows time steps of 2 fs.
+			 */
+			static const char* CONSTRAIN_H_BONDS;
+
+			/** Keep water molecules rigid (SETTLE)
+			 */
+			static const char* RIGID_WATER;
+
+			/** The relative tolerance of the constraint solver
+			 */
+			static const char* CONSTRAINT_TOLERANCE;
+
+			/** The number of inner (bonded force) steps per time step of a
+					multiple time step simulation
+			 */
+			static const char* NUMBER_OF_INNER_STEPS;
 		};
 
 		struct BALL_EXPORT Default
@@ -129,6 +151,22 @@ namespace BALL
 			 *  Useful when doing several successive MD runs on the system 
 			 */
 			static const double CURRENT_TIME;
+
+			/** Constrain the bonds containing hydrogen atoms. Default = false
+			 */
+			static const bool CONSTRAIN_H_BONDS;
+
+			/** Keep water molecules rigid. Default = false
+			 */
+			static const bool RIGID_WATER;
+
+			/** The relative tolerance of the constraint solver. Default = 1e-6
+			 */
+			static const double CONSTRAINT_TOLERANCE;
+
+			/** The number of inner steps per time step. Default = 4
+			 */
+			static const Size NUMBER_OF_INNER_STEPS;
 		};
 
 		/** @name Constructors and Destructors  
@@ -287,6 +325,14 @@ namespace BALL
 		*/
 		ForceField* getForceField() const;
 
+		/**  Get the constraint solver.
+				 The constraints are determined in  \link setup setup \endlink and at the
+				 beginning of each simulation according to the options
+				 \link Option::CONSTRAIN_H_BONDS CONSTRAIN_H_BONDS \endlink and
+				 \link Option::RIGID_WATER RIGID_WATER \endlink.
+		*/
+		const ConstraintSolver& getConstraintSolver() const;
+
 		/** Start the molecular dynamics simulation.
 				This method calls  \link simulateIterations simulateIterations \endlink  with the maximum 
 				number of iterations.
@@ -351,6 +397,11 @@ namespace BALL
 		*/
 		void updateInstantaneousTemperature();
 
+		/*_ Determine the constraints for the current atom vector
+				according to the options.
+		*/
+		void setupConstraints_();
+
 		//_@}
 		/*_ @name Protected Attributes
 		*/
@@ -418,6 +469,10 @@ namespace BALL
 		*/
 		SnapShotManager* snapshot_manager_ptr_;
 
+		/*_  The constraints (bonds to hydrogen atoms, rigid water)
+		*/
+		ConstraintSolver constraint_solver_;
+
 		//_ 
 		bool abort_by_energy_enabled_;
 		
@@ -0,0 +1,202 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_MOLMEC_MDSIMULATION_MULTIPLETIMESTEPMD_H
+#define BALL_MOLMEC_MDSIMULATION_MULTIPLETIMESTEPMD_H
+
+#ifndef BALL_MOLMEC_MDSIMULATION_MOLECULARDYNAMICS_H
+#	include <BALL/MOLMEC/MDSIMULATION/molecularDynamics.h>
+#endif
+
+#ifndef BALL_MATHS_VECTOR3_H
+#	include <BALL/MATHS/vector3.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	class ForceFieldComponent;
+
+	/** Multiple time step MD: microcanonical (NVE) molecular dynamics with
+			the reversible RESPA integrator (M. Tuckerman, B.J. Berne and
+			G.J. Martyna, J. Chem. Phys. 97 (1992), 1990-2001).
+			\par
+			The components of the force field are split into fast (bonded) and
+			slow (all other) components. The fast forces are integrated with
+			<tt>number_of_inner_steps</tt> Velocity Verlet steps of length
+			<tt>time_step / number_of_inner_steps</tt>, the slow forces are
+			applied as half kicks at the beginning and the end of each time step.
+			The expensive non-bonded components are thus evaluated only once per
+			(outer) time step. The slow forces are kept in a separate buffer,
+			the forces of the atoms contain the fast forces during the inner steps
+			and the total force at the end of each time step.
+			\par
+			By default, a component is fast if its name contains
+			<tt>Stretch</tt>, <tt>Bend</tt> or <tt>Torsion</tt>, i.e. the
+			stretch, bend and (improper) torsion components of AMBER, CHARMM and MMFF94.
+			This can be changed by overriding  \link isFastComponent isFastComponent \endlink.
+			\par
+			Typical settings are an outer time step of 2 fs with four inner steps
+			of 0.5 fs, or 3 fs with three inner steps and constrained bonds to hydrogen atoms.
+			Larger outer time steps are limited by the fastest non-bonded (1-4) interactions.
+			Constraints are applied in every inner step.
+
+    	\ingroup  MDSimulation
+	*/
+	class BALL_EXPORT MultipleTimeStepMD : public MolecularDynamics
+	{
+		public:
+
+		/** @name Constructors and Destructors.
+		*/
+		//@{
+
+		BALL_CREATE(MultipleTimeStepMD)
+
+		/// Default constructor
+		MultipleTimeStepMD();
+
+		/** Constructor.
+				The force field's options are used and no snapshots are taken.
+		*/
+		MultipleTimeStepMD(ForceField& force_field);
+
+		/** Constructor.
+				The force field's options are used.
+		*/
+		MultipleTimeStepMD(ForceField& force_field, SnapShotManager* ssm);
+
+		/** Constructor.
+		*/
+		MultipleTimeStepMD(ForceField& force_field, SnapShotManager* ssm, const Options& options);
+
+		/// Copy constructor
+		MultipleTimeStepMD(const MultipleTimeStepMD& rhs);
+
+		/// Destructor
+		virtual ~MultipleTimeStepMD();
+
+		//@}
+		/** @name Assignment
+		*/
+		//@{
+
+		/// Assignment operator
+		MultipleTimeStepMD& operator = (const MultipleTimeStepMD& rhs);
+
+		//@}
+		/** @name Setup methods
+		*/
+		//@{
+
+		/// General setup
+		virtual bool setup(ForceField& force_field, SnapShotManager* ssm);
+
+		/// General setup
+		virtual bool setup(ForceField& force_field, SnapShotManager* ssm, const Options& options);
+
+		/// Read the number of inner steps from the options
+		virtual bool specificSetup();
+
+		//@}
+		/** @name Accessors
+		*/
+		//@{
+
+		/** Set the number of inner steps per time step.
+				The inner time step is  \link getTimeStep getTimeStep \endlink divided by this number.
+		*/
+		void setNumberOfInnerSteps(Size number);
+
+		/// Return the number of inner steps per time step
+		Size getNumberOfInnerSteps() const;
+
+		/** Return the number of evaluations of the slow forces since the last
+				call of  \link simulateIterations simulateIterations \endlink without restart.
+		*/
+		Size getNumberOfSlowForceEvaluations() const;
+
+		/** Return the number of evaluations of the fast forces since the last
+				call of  \link simulateIterations simulateIterations \endlink without restart.
+		*/
+		Size getNumberOfFastForceEvaluations() const;
+
+		/** Decide whether a force field component is integrated with the inner time step.
+				The default implementation returns true for components whose name contains
+				<tt>Stretch</tt>, <tt>Bend</tt> or <tt>Torsion</tt>.
+		*/
+		virtual bool isFastComponent(const ForceFieldComponent& component) const;
+
+		/** Run the simulation for the given number of (outer) time steps.
+				restart = true means that the counting of iterations is
+				continued from the previous run.
+		*/
+		virtual bool simulateIterations(Size number, bool restart = false);
+
+		//@}
+
+		protected:
+
+		/*_ @name Protected methods
+		*/
+		//_@{
+
+		/*_ Sort the enabled components of the force field into fast and slow ones
+		*/
+		void assignComponents_();
+
+		/*_ Compute the forces of the given components and store them in forces.
+				The forces are computed by ForceField::updateForces() with all other
+				components temporarily disabled. The atom forces are overwritten.
+		*/
+		void computeForces_(const std::vector<ForceFieldComponent*>& components, std::vector<Vector3>& forces);
+
+		/*_ Update the velocities by the given forces: v += time * F / m
+		*/
+		void kick_(const std::vector<Vector3>& forces, double time);
+
+		//_@}
+		/*_ @name Protected Attributes
+		*/
+		//_@{
+
+		/*_ The number of inner steps per time step
+		*/
+		Size number_of_inner_steps_;
+
+		/*_ The bonded components, evaluated in each inner step
+		*/
+		std::vector<ForceFieldComponent*> fast_components_;
+
+		/*_ The non-bonded components, evaluated once per time step
+		*/
+		std::vector<ForceFieldComponent*> slow_components_;
+
+		/*_ The fast forces of all atoms
+		*/
+		std::vector<Vector3> fast_forces_;
+
+		/*_ The slow forces of all atoms
+		*/
+		std::vector<Vector3> slow_forces_;
+
+		/*_ The factors converting forces (N) into accelerations (A/ps^2) for all atoms
+		*/
+		std::vector<double> acceleration_factors_;
+
+		/*_ The number of slow force evaluations
+		*/
+		Size number_of_slow_evaluations_;
+
+		/*_ The number of fast force evaluations
+		*/
+		Size number_of_fast_evaluations_;
+
+		//_@}
+	};
+
+} // namespace BALL
+
+#endif // BALL_MOLMEC_MDSIMULATION_MULTIPLETIMESTEPMD_H
@@ -0,0 +1,368 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_MOLMEC_MINIMIZATION_BATCHMINIMIZER_H
+#define BALL_MOLMEC_MINIMIZATION_BATCHMINIMIZER_H
+
+#ifndef BALL_MOLMEC_MINIMIZATION_CONJUGATEGRADIENT_H
+#	include <BALL/MOLMEC/MINIMIZATION/conjugateGradient.h>
+#endif
+
+#ifndef BALL_KERNEL_SYSTEM_H
+#	include <BALL/KERNEL/system.h>
+#endif
+
+#ifndef BALL_DATATYPE_OPTIONS_H
+#	include <BALL/DATATYPE/options.h>
+#endif
+
+#ifndef BALL_SYSTEM_SYSINFO_H
+#	include <BALL/SYSTEM/sysinfo.h>
+#endif
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <vector>
+
+namespace BALL
+{
+	/** Minimization of many conformations of the same molecular system.
+			A BatchMinimizer minimizes a batch of conformations, e.g. docking poses, that share
+			one topology. It keeps one copy of the topology, one force field of type ForceFieldType and
+			one minimizer of type MinimizerType per thread. The expensive force field setup (parameter
+			file parsing, atom typing, charge and parameter assignment) is thus performed once per thread
+			instead of once per conformation. For each conformation, only the coordinates are copied into
+			the thread's system, the force field is updated (e.g. its pair lists) and the minimizer is reset.
+			\par
+			The threads work on disjoint conformations and coordinate/gradient buffers, so the results do
+			not depend on the number of threads.
+			\par
+			The force fields are set up sequentially, the minimizations run concurrently.
+			ForceFieldType has to provide a constructor taking a System and Options, MinimizerType
+			a constructor taking a ForceField. Example:
+			\code
+				BatchMinimizer<AmberFF> minimizer(complex);
+				minimizer.setNumberOfThreads(4);
+				minimizer.setMaxNumberOfIterations(500);
+				std::vector<BatchMinimizer<AmberFF>::Result> results;
+				minimizer.minimize(poses, results);
+			\endcode
+
+			\ingroup  MolmecEnergyMinimizer
+	*/
+	template <typename ForceFieldType, typename MinimizerType = ConjugateGradientMinimizer>
+	class BatchMinimizer
+	{
+		public:
+
+		/**	@name	Type definitions
+		*/
+		//@{
+
+		/// The atom positions of one conformation, in the order of an AtomIterator over the topology
+		typedef std::vector<Vector3> Conformation;
+
+		/// The result of the minimization of one conformation.
+		struct Result
+		{
+			/// the energy after the minimization
+			double energy;
+			/// the energy before the minimization
+			double initial_energy;
+			/// the number of iterations performed
+			Size number_of_iterations;
+			/// true if the minimizer converged
+			bool converged;
+			/// the minimized atom positions
+			Conformation positions;
+		};
+		//@}
+
+		/**	@name	Constructors and Destructors
+		*/
+		//@{
+
+		BALL_CREATE(BatchMinimizer)
+
+		/// Default constructor
+		BatchMinimizer()
+			:	force_field_options(),
+				minimizer_options(),
+				topology_(),
+				number_of_threads_(1),
+				max_number_of_iterations_(1000),
+				max_gradient_(0.0),
+				workers_()
+		{
+		}
+
+		/** Detailed constructor.
+				@param topology the system defining the topology of all conformations
+				@param new_force_field_options the options used for the setup of the force fields
+				@param new_minimizer_options the options used for the setup of the minimizers
+		*/
+		BatchMinimizer(const System& topology, const Options& new_force_field_options = Options(),
+		               const Options& new_minimizer_options = Options())
+			:	force_field_options(new_force_field_options),
+				minimizer_options(new_minimizer_options),
+				topology_(topology),
+				number_of_threads_(1),
+				max_number_of_iterations_(1000),
+				max_gradient_(0.0),
+				workers_()
+		{
+		}
+
+		/// Copy constructor, the per-thread force fields are not copied
+		BatchMinimizer(const BatchMinimizer& minimizer)
+			:	force_field_options(minimizer.force_field_options),
+				minimizer_options(minimizer.minimizer_options),
+				topology_(minimizer.topology_),
+				number_of_threads_(minimizer.number_of_threads_),
+				max_number_of_iterations_(minimizer.max_number_of_iterations_),
+				max_gradient_(minimizer.max_gradient_),
+				workers_()
+		{
+		}
+
+		/// Destructor
+		virtual ~BatchMinimizer()
+		{
+			clearWorkers_();
+		}
+		//@}
+
+		/**	@name	Accessors
+		*/
+		//@{
+
+		/// Set the topology, all per-thread force fields are discarded
+		void setTopology(const System& topology)
+		{
+			clearWorkers_();
+			topology_ = topology;
+		}
+
+		/// Return the topology
+		const System& getTopology() const { return topology_; }
+
+		/// Set the number of threads (capped by the number of processors)
+		void setNumberOfThreads(Size number_of_threads) { number_of_threads_ = std::max((Size)1, number_of_threads); }
+
+		/// Return the number of threads
+		Size getNumberOfThreads() const { return number_of_threads_; }
+
+		/// Set the maximal number of iterations per conformation
+		void setMaxNumberOfIterations(Size number_of_iterations) { max_number_of_iterations_ = number_of_iterations; }
+
+		/// Return the maximal number of iterations per conformation
+		Size getMaxNumberOfIterations() const { return max_number_of_iterations_; }
+
+		/// Set the RMS gradient criterion for convergence, 0 uses the minimizer's default
+		void setMaxGradient(float max_gradient) { max_gradient_ = max_gradient; }
+
+		/// Return the RMS gradient criterion for convergence
+		float getMaxGradient() const { return max_gradient_; }
+		//@}
+
+		/**	@name	Minimization
+		*/
+		//@{
+
+		/** Set up one force field and minimizer per thread.
+				This is called by \link minimize minimize \endlink if necessary. Calling it
+				explicitly allows to separate the setup time from the minimization time.
+				@return false if any of the force fields could not be set up
+		*/
+		bool setup()
+		{
+			Size number_of_threads = number_of_threads_;
+			Index number_of_processors = SysInfo::getNumberOfProcessors();
+			if ((number_of_processors > 0) && (number_of_threads > (Size)number_of_processors))
+			{
+				number_of_threads = number_of_processors;
+			}
+
+			if (workers_.size() == number_of_threads)
+			{
+				return true;
+			}
+
+			clearWorkers_();
+			for (Position i = 0; i < number_of_threads; ++i)
+			{
+				Worker_* worker = new Worker_;
+				worker->system = topology_;
+				worker->force_field = new ForceFieldType(worker->system, force_field_options);
+				worker->minimizer = 0;
+				workers_.push_back(worker);
+
+				if (!worker->force_field->isValid())
+				{
+					Log.error() << "BatchMinimizer: force field setup failed." << std::endl;
+					clearWorkers_();
+					return false;
+				}
+
+				for (AtomIterator at_it = worker->system.beginAtom(); +at_it; ++at_it)
+				{
+					worker->atoms.push_back(&*at_it);
+				}
+				// add the options to the minimizer's defaults instead of replacing them
+				worker->minimizer = new MinimizerType(*worker->force_field);
+				for (Options::ConstIterator it = minimizer_options.begin(); it != minimizer_options.end(); ++it)
+				{
+					worker->minimizer->options[it->first] = it->second;
+				}
+			}
+
+			return true;
+		}
+
+		/** Minimize a batch of conformations.
+				@param conformations the atom positions of all conformations
+				@param results buffer for result delivery, one entry per conformation
+				@return the number of converged minimizations
+				@throw Exception::InvalidArgument if the size of a conformation does not match the topology
+		*/
+		Size minimize(const std::vector<Conformation>& conformations, std::vector<Result>& results)
+		{
+			Size number_of_atoms = topology_.countAtoms();
+			for (Position i = 0; i < conformations.size(); ++i)
+			{
+				if (conformations[i].size() != number_of_atoms)
+				{
+					throw Exception::InvalidArgument(__FILE__, __LINE__,
+						String("BatchMinimizer: conformation ") + String(i) + " has " + String((Size)conformations[i].size())
+						+ " atoms, the topology has " + String(number_of_atoms));
+				}
+			}
+
+			results.resize(conformations.size());
+			if (conformations.empty() || !setup())
+			{
+				return 0;
+			}
+
+			if (workers_.size() == 1)
+			{
+				minimizeRange_(workers_[0], &conformations, &results, 0, 1);
+			}
+			else
+			{
+				boost::thread_group threads;
+				for (Position i = 0; i < workers_.size(); ++i)
+				{
+					threads.create_thread(boost::bind(&BatchMinimizer::minimizeRange_, this,
+					                                  workers_[i], &conformations, &results, i, workers_.size()));
+				}
+				threads.join_all();
+			}
+
+			Size number_of_converged = 0;
+			for (Position i = 0; i < results.size(); ++i)
+			{
+				if (results[i].converged)
+				{
+					++number_of_converged;
+				}
+			}
+
+			return number_of_converged;
+		}
+		//@}
+
+		/** @name Public Attributes
+		*/
+		//@{
+		/// The options used for the setup of the force fields
+		Options force_field_options;
+
+		/// The options used for the setup of the minimizers
+		Options minimizer_options;
+		//@}
+
+		protected:
+
+		//_ The state of one thread.
+		struct Worker_
+		{
+			System system;
+			ForceFieldType* force_field;
+			MinimizerType* minimizer;
+			std::vector<Atom*> atoms;
+		};
+
+		//_ Thread worker: minimize every stride-th conformation starting at first
+		void minimizeRange_(Worker_* worker, const std::vector<Conformation>* conformations,
+		                    std::vector<Result>* results, Position first, Size stride)
+		{
+			for (Position i = first; i < conformations->size(); i += stride)
+			{
+				const Conformation& conformation = (*conformations)[i];
+				for (Position j = 0; j < worker->atoms.size(); ++j)
+				{
+					worker->atoms[j]->setPosition(conformation[j]);
+				}
+
+				// rebuild pair lists for the new coordinates and reset the minimizer
+				worker->force_field->update();
+				worker->minimizer->setup(*worker->force_field);
+				worker->minimizer->setMaxNumberOfIterations(max_number_of_iterations_);
+				if (max_gradient_ > 0.0)
+				{
+					worker->minimizer->setMaxGradient(max_gradient_);
+				}
+
+				Result& result = (*results)[i];
+				result.initial_energy = worker->force_field->updateEnergy();
+				result.converged = worker->minimizer->minimize(max_number_of_iterations_);
+				result.number_of_iterations = worker->minimizer->getNumberOfIterations();
+				result.energy = worker->force_field->updateEnergy();
+
+				result.positions.resize(worker->atoms.size());
+				for (Position j = 0; j < worker->atoms.size(); ++j)
+				{
+					result.positions[j] = worker->atoms[j]->getPosition();
+				}
+			}
+		}
+
+		//_ Delete all per-thread force fields and minimizers
+		void clearWorkers_()
+		{
+			for (Position i = 0; i < workers_.size(); ++i)
+			{
+				delete workers_[i]->minimizer;
+				delete workers_[i]->force_field;
+				delete workers_[i];
+			}
+			workers_.clear();
+		}
+
+		//_ The topology
+		System topology_;
+
+		//_ The number of threads
+		Size number_of_threads_;
+
+		//_ The maximal number of iterations per conformation
+		Size max_number_of_iterations_;
+
+		//_ The convergence criterion, 0 for the minimizer's default
+		float max_gradient_;
+
+		//_ One system, force field and minimizer per thread
+		std::vector<Worker_*> workers_;
+
+		private:
+
+		// the per-thread state cannot be shared
+		BatchMinimizer& operator = (const BatchMinimizer&);
+	};
+
+} // namespace BALL
+
+#endif // BALL_MOLMEC_MINIMIZATION_BATCHMINIMIZER_H
@@ -15,6 +15,10 @@
 # include <BALL/MOLMEC/MINIMIZATION/lineSearch.h>
 #endif
 
+#ifndef BALL_MOLMEC_COMMON_FLATVECTOR_H
+#	include <BALL/MOLMEC/COMMON/flatVector.h>
+#endif
+
 namespace BALL 
 {
 	/** Limited-memory BFGS minimizer based on the Strang recurrence.
@@ -205,21 +209,21 @@ namespace BALL
 			
 			/** Old and new scaling values. Also used in the Strang recurrence formula.
 			*/
-			vector<float> rho_;
+			vector<double> rho_;
 			
-			/** Stored former steps. Vectors stored in column order.
+			/** Stored former steps. Vectors of 3N floats stored in column order.
 			*/
-			vector<Vector3> stored_s_;
+			FlatVector::Array stored_s_;
 			
 			/** Stored former changes in gradients.
-			 *  Vectors stored in column order.
+			 *  Vectors of 3N floats stored in column order.
 			 */
-			vector<Vector3> stored_y_;
+			FlatVector::Array stored_y_;
 			
 			/** Temporarily used memory for saving scalars associated with
 			 *  the stored vector pairs.
 			 */
-			vector<float> work_val_;
+			vector<double> work_val_;
 			
 			/** Index of the vector pair which will be used for saving the data
 			 *  of the current step (usually by replacing old data).
@@ -74,6 +74,13 @@ namespace BALL
 				If the substance to be predicted is part of the same input data (e.g. same SD-file) as the training data (as is the case during cross validation), transform should therefore be set to 0. 
 				@return a RowVector containing one value for each predicted activity*/
 				virtual Eigen::VectorXd predict(const vector<double>& substance, bool transform) =0; 
+
+				/** Predicts the activities of several substances at once. \n
+				The default implementation calls predict() for each substance; linear and kernel-based models predict all substances by a few matrix operations instead.
+				@param substances a matrix containing one row for each substance and the values of the *selected* descriptors only, in the order of getDescriptorIDs() and getDescriptorNames(). If no feature selection was done, the values of all descriptors.
+				@param transform as for predict()
+				@return a matrix containing one row for each substance and one column for each predicted activity */
+				virtual Eigen::MatrixXd predictBatch(const Eigen::MatrixXd& substances, bool transform=1);
 				
 				/** removes all entries from descriptor_IDs */
 				void deleteDescriptorIDs();
@@ -167,8 +174,14 @@ namespace BALL
 				
 				Eigen::VectorXd getSubstanceVector(const Eigen::VectorXd& substance, bool transform);
 				
+				/** returns the given substances (one row for each substance, see predictBatch()) after checking their number of descriptors and, if desired, transforming them according to the centering of the training data */
+				Eigen::MatrixXd getSubstanceMatrix(const Eigen::MatrixXd& substances, bool transform);
+				
 				/** transforms a prediction (obtained by Model.train()) according to the inverse of the transformation(s) of the activity values of the training data */
 				void backTransformPrediction(Eigen::VectorXd& pred);
+
+				/** transforms the predictions for several substances (one row for each substance) as backTransformPrediction() */
+				void backTransformPredictions(Eigen::MatrixXd& predictions);
 				
 				/** adds offset lambda to the diagonal of the given matrix */
 				void addLambda(Eigen::MatrixXd& matrix, double& lambda);
@@ -132,8 +132,26 @@ namespace BALL
 				/** saves the current QSARData object to a text file */
 				void saveToFile(string filename) const;
 				
-				/** reconstructs a QSARData object from a text file */
+				/** reconstructs a QSARData object from a text file, or from a binary file written by saveToBinaryFile() */
 				void readFromFile(string filename);
+
+				/** saves the current QSARData object to a binary file.\n
+				The file serves as a cache of descriptors: the descriptor and response values are stored column by column in 64 byte aligned sections behind a versioned header, so that they are read without parsing. In contrast to saveToFile(), no precision is lost. Values are stored in the byte order of the writing machine.
+				@throw BALL::Exception::FileNotFound if the file cannot be opened
+				@throw File::CannotWrite if the file cannot be written completely */
+				void saveToBinaryFile(const String& filename) const;
+
+				/** reconstructs a QSARData object from a binary file written by saveToBinaryFile().\n
+				The file is memory mapped and each column is copied as one block into the matrices of this object. The object is not modified if the file is invalid.
+				@throw BALL::Exception::FileNotFound if the file cannot be opened
+				@throw WrongFileFormat if the file is no binary QSARData file of this version and byte order */
+				void readFromBinaryFile(const String& filename);
+
+				/** returns true if the given file starts like a binary file written by saveToBinaryFile() */
+				static bool isBinaryFile(const String& filename);
+
+				/** the version of the binary file format */
+				static const Size BINARY_FORMAT_VERSION;
 				
 				/** generates a training and an external validation set from the current QSARData object 
 				@param fraction the fraction of this current coumpounds that should be used as external validation set (by random drawing) */
@@ -165,6 +183,17 @@ namespace BALL
 				
 				/** allows to set the data-folder neccessary for computation of descriptors without using BALL_DATA_PATH enviroment variable, which is useful for standalone applications */
 				void setDataFolder(const char* folder);
+
+				/** sets the number of threads that calculate the descriptors while readSDFile() reads the molecules (default: 1).\n
+				The threads fill preallocated rows of descriptor_matrix_, so the order of the substances does not depend on the number of threads. */
+				void setNumberOfThreads(Size number_of_threads);
+
+				/** returns the number of threads used for the calculation of descriptors */
+				Size getNumberOfThreads() const;
+
+				/** returns the time in seconds spent on each descriptor calculated by BALL during the last call of readSDFile(), summed over all threads and listed in the order of the columns of descriptor_matrix_. \n
+				Descriptors derived from the same base class are calculated together when the first of them is requested, so the entry of this descriptor contains the time of the whole group. All counts of functional groups are listed as one entry "FunctionalGroups". */
+				const std::vector<std::pair<String, double> >& getDescriptorTimings() const;
 				
 				/** removes compounds whose absolute correlation coefficient to another compound is larger than cor_threshold 
 				@param feature_cor_threshold Only features that do not have a correlation larger than this value to another feature are used to calculate the similarity of compounds (=instances). */
@@ -190,6 +219,9 @@ namespace BALL
 				*/
 				void calculateBALLDescriptors(Molecule& m);
 
+				/** creates the 60 descriptors calculated by calculateBALLDescriptors() in the order of their columns. The caller takes ownership of the descriptors. */
+				void createBALLDescriptors(std::vector<Descriptor*>& descriptors) const;
+
 				/** Calculates topological descriptors based on functional groups counts done by SMARTS matching */
 				void calculateTopologicalDescriptors(Molecule& mol, MolecularSimilarity& molsim, const std::map<String,int>& descriptor_map);
 
@@ -247,16 +279,25 @@ namespace BALL
 				
 				/** in case of classification data sets with non-numeric class labels, this member maps the names of the individual classes to their assigned id. */ 
 				std::map<String,int> class_names_;
+
+				/** number of threads used for the calculation of descriptors */
+				Size number_of_threads_;
+
+				/** time spent on each descriptor during the last call of readSDFile() */
+				std::vector<std::pair<String, double> > descriptor_timings_;
 				//@}
 
 				
 				
+				friend class DescriptorPipeline;
 				friend class ClassificationValidation;
 				friend class RegressionValidation;
 				friend class Validation;
 				friend class Model;
 				friend class FitModel;
 				friend class FeatureSelection;
+				friend class BatchPredictor;
+				friend class IncrementalCrossValidation;
 	
 		};
 
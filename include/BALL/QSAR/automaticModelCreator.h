@@ -25,15 +25,22 @@ namespace BALL
 
 				void setMinQuality(double min_quality);
 
+				/** sets the number of threads used for the validation of the models and for the kernel matrices of kernel models, see Validation::setNumberOfThreads() and Kernel::setNumberOfThreads() (default: 1) */
+				void setNumberOfThreads(Size number_of_threads);
+
 			private:
 
 				void optimizeParameters(Model* model);
 
 				void selectFeatures(Model* model);
 
+				void setKernelThreads(Model* model);
+
 				const QSARData* data_;
 
 				double min_quality_;
+
+				Size number_of_threads_;
 		};
 
 	}
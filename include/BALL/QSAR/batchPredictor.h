@@ -0,0 +1,146 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+//
+
+#ifndef BALL_QSAR_BATCHPREDICTOR_H
+#define BALL_QSAR_BATCHPREDICTOR_H
+
+#ifndef BALL_QSAR_MODEL_H
+#include <BALL/QSAR/Model.h>
+#endif
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace BALL
+{
+	class MolecularSimilarity;
+
+	namespace QSAR
+	{
+		class DescriptorPipeline;
+
+		/** Predicts the activities of large numbers of molecules with a model that has been saved to a file.\n
+		The model is read only once. For the molecules passed to predict(), only those descriptors are calculated
+		that the model uses, i.e. that are listed in Model::getDescriptorNames(): BALL descriptors and functional
+		group counts are calculated by several threads at once, all other descriptors are read from the properties
+		of the molecules. The activities of all given molecules are then predicted by Model::predictBatch().\n
+		Since predict() can be called repeatedly, a molecule file of any size can be processed chunk by chunk
+		without keeping its molecules or their descriptors in memory. */
+		class BALL_EXPORT BatchPredictor
+		{
+			public:
+				/** @name Constructors and Destructors
+				 */
+				//@{
+				/** reads the model from the given file, see createNewModelFromFile() */
+				BatchPredictor(const String& model_file);
+
+				~BatchPredictor();
+				//@}
+
+
+				/** @name Accessors
+				 */
+				//@{
+				/** returns the model read from the file */
+				Model* getModel();
+
+				/** sets the folder containing the parameter files of the BALL descriptors, see QSARData::setDataFolder() */
+				void setDataFolder(const char* folder);
+
+				/** sets the number of threads that calculate the descriptors and, for kernel-based models, the kernel matrix (default: 1) */
+				void setNumberOfThreads(Size number_of_threads);
+
+				Size getNumberOfThreads() const;
+
+				/** returns the number of BALL descriptors calculated for each molecule, not counting functional groups */
+				Size getNumberOfBALLDescriptors() const;
+
+				/** returns the number of functional groups counted for each molecule */
+				Size getNumberOfFunctionalGroups() const;
+
+				/** returns the number of descriptors read from the properties of each molecule */
+				Size getNumberOfPropertyDescriptors() const;
+
+				/** returns true if all descriptors to be read from the properties of the given molecule are present and numerical */
+				bool hasPropertyDescriptors(const Molecule& mol) const;
+
+				/** calculates the descriptors used by the model for the given molecules.
+				@param descriptors a matrix containing one row for each molecule and one column for each descriptor in the order of Model::getDescriptorNames()
+				@throw Exception::PropertyError if a descriptor to be read from the properties of a molecule is missing or not numerical */
+				void calculateDescriptors(const std::vector<Molecule*>& molecules, Eigen::MatrixXd& descriptors);
+
+				/** predicts the activities of the given molecules
+				@param predictions a matrix containing one row for each molecule and one column for each predicted activity */
+				void predict(const std::vector<Molecule*>& molecules, Eigen::MatrixXd& predictions);
+
+				/** predicts the activities of molecules whose descriptors have been calculated by calculateDescriptors() */
+				void predict(const Eigen::MatrixXd& descriptors, Eigen::MatrixXd& predictions);
+
+				/** returns the number of molecules predicted so far */
+				Size getNumberOfPredictions() const;
+
+				/** returns the time in seconds spent on the calculation of descriptors so far */
+				double getDescriptorTime() const;
+
+				/** returns the time in seconds spent on the prediction of activities from descriptors so far */
+				double getPredictionTime() const;
+				//@}
+
+
+			protected:
+
+				/** determines for each descriptor of the model how it is obtained */
+				void assignDescriptors();
+
+				/** creates the pipeline that calculates the BALL descriptors and functional groups, if not done yet */
+				void createPipeline();
+
+				void deletePipeline();
+
+				/** reads the p-th property descriptor of the molecule, returns false if it is missing or not numerical */
+				bool readPropertyDescriptor(const Molecule& mol, Position p, double& value) const;
+
+
+				/** @name Attributes
+				 */
+				//@{
+				/** the (empty) data set the model is bound to */
+				QSARData data_;
+
+				Model* model_;
+
+				Size number_of_threads_;
+
+				/** columns of the model and the positions of the respective BALL descriptors among the 60 descriptors of QSARData */
+				std::vector<std::pair<Position, Position> > ball_descriptors_;
+
+				/** columns of the model and the indices of the respective functional groups */
+				std::vector<std::pair<Position, Position> > functional_groups_;
+
+				/** columns of the model and the names of the respective properties */
+				std::vector<std::pair<Position, String> > property_descriptors_;
+
+				/** counts the functional groups */
+				MolecularSimilarity* molsim_;
+
+				/** calculates the BALL descriptors and functional groups by several threads */
+				DescriptorPipeline* pipeline_;
+
+				/** the columns written by pipeline_ */
+				VMatrix pipeline_columns_;
+
+				Size number_of_predictions_;
+
+				double descriptor_time_;
+
+				double prediction_time_;
+				//@}
+		};
+	}
+}
+
+#endif // BALL_QSAR_BATCHPREDICTOR_H
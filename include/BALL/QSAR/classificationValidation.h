@@ -83,11 +83,34 @@ namespace BALL
 				
 				
 			private:
+				/** the result of one fold, bootstrap sample or response permutation run, see Validation::runTasks() */
+				struct TaskResult
+				{
+					EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+					double quality;
+					double fit;
+					Eigen::VectorXd class_results;
+					Eigen::VectorXd class_results_fit;
+				};
+
 				/** @name Accessors
 				 */
 				//@{
 				/** Tests the current model with all substances in the (unchanged) test data set */
 				void testAllSubstances(bool transform);
+
+				/** trains the model of the given validation object on all folds but the given one and tests it on this fold */
+				static void crossValidationTask(Validation* validation, Position fold, int k, vector<TaskResult>* results);
+
+				/** trains the model of the given validation object on the given bootstrap sample and tests it */
+				static void bootstrapTask(Validation* validation, Position sample, unsigned int seed, vector<TaskResult>* results);
+
+				/** randomizes the response values of the data of the given validation object and validates its model */
+				static void yRandomizationTask(Validation* validation, Position run, int k, unsigned int seed, const VMatrix* response_values, vector<TaskResult>* results);
+
+				/** returns the mean of the class results of all tasks; results of models that know fewer classes are padded with zeros */
+				static Eigen::VectorXd averageClassResults(const vector<TaskResult>& results, bool fit);
 				
 				/** calculate average accuracy with the current values of TP, FP, FN, TN in matrix ClassificationValidation.predictions. */
 				void calculateAverageSensitivity();
@@ -27,6 +27,7 @@ namespace BALL
 			bool center_data;
 			bool center_y;
 			String output;
+			bool binary_output;
 			double validation_fraction;
 			bool separate_activity_file;
 			bool within_section;
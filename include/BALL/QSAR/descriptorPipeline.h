@@ -0,0 +1,140 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+//
+
+#ifndef BALL_QSAR_DESCRIPTORPIPELINE_H
+#define BALL_QSAR_DESCRIPTORPIPELINE_H
+
+#ifndef QSARH
+#include <BALL/QSAR/QSARData.h>
+#endif
+
+#include <map>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+namespace boost
+{
+	class thread_group;
+}
+
+namespace BALL
+{
+	class MolecularSimilarity;
+
+	namespace QSAR
+	{
+		/** Calculates BALL descriptors and counts of functional groups for a stream of molecules.\n
+		The molecules passed to push() are collected in chunks; each chunk is calculated by several worker threads, while the calling thread continues to push the molecules of the next chunk. The descriptors of each molecule are written into the next row of the given columns of a descriptor matrix, so the order of the rows does not depend on the number of threads.\n
+		Used by QSARData::readSDFile() and by BatchPredictor. */
+		class BALL_EXPORT DescriptorPipeline
+		{
+			public:
+				/** @name Constructors and Destructors
+				 */
+				//@{
+				/** calculates the descriptors of the molecules read by QSARData::readSDFile() into the descriptor matrix of the data set, using its number of threads.
+				@param calc_phychem_properties if true, all BALL descriptors are calculated into the first columns
+				@param molsim if not 0, the functional groups of molsim are counted; their columns are looked up by name in descriptor_map when the first chunk starts
+				The molecules are deleted once their descriptors have been calculated, and the time spent on each descriptor is stored in QSARData::descriptor_timings_. */
+				DescriptorPipeline(QSARData& data, bool calc_phychem_properties, MolecularSimilarity* molsim, const std::map<String, int>& descriptor_map);
+
+				/** calculates the given descriptors only; the molecules passed to push() are not deleted.
+				@param data the data set whose data folder is used to create the BALL descriptors
+				@param matrix the descriptor matrix; only the given columns are written
+				@param ball_descriptors pairs of the column and the position among the descriptors created by QSARData::createBALLDescriptors()
+				@param molsim if not 0, counts the functional groups
+				@param functional_groups pairs of the column and the index of the functional group of molsim */
+				DescriptorPipeline(const QSARData& data, VMatrix& matrix, Size number_of_threads,
+				                   const std::vector<std::pair<Position, Position> >& ball_descriptors,
+				                   MolecularSimilarity* molsim, const std::vector<std::pair<Position, Position> >& functional_groups);
+
+				/** waits for the workers and deletes the molecules owned by the pipeline */
+				~DescriptorPipeline();
+				//@}
+
+
+				/** @name Accessors
+				 */
+				//@{
+				/** writes the descriptors of the molecule into the next row of the descriptor matrix */
+				void push(Molecule* mol);
+
+				/** calculates the descriptors of all remaining molecules and waits for the workers.\n
+				Further molecules may be pushed afterwards; their rows are appended to the columns as they are then.
+				@throw Exception::GeneralException with the name and message of the first error of any worker */
+				void finish();
+				//@}
+
+
+			protected:
+
+				/** creates the BALL descriptors of each thread, keeping those at the given positions */
+				void createDescriptors_(const QSARData& data, Size number_of_threads, const std::vector<Position>& positions);
+
+				/** calculates the descriptors of the molecules pushed so far, by the workers if more than one thread is used */
+				void startChunk_();
+
+				/** waits for the workers and releases their molecules */
+				void joinChunk_();
+
+				/** calculates the descriptors of the molecules first, first+step, ... of the running chunk */
+				void calculate_(Position thread, Position first, Size step);
+
+				/** thread function, keeps the first error of all workers */
+				void calculateThread_(Position thread, Position first, Size step);
+
+
+				/** @name Attributes
+				 */
+				//@{
+				VMatrix& matrix_;
+
+				/** the timings of QSARData::readSDFile(), 0 if not recorded */
+				std::vector<std::pair<String, double> >* descriptor_timings_;
+
+				MolecularSimilarity* molsim_;
+
+				/** the names of the columns of the functional groups, 0 if functional_groups_ is given */
+				const std::map<String, int>* descriptor_map_;
+
+				bool delete_molecules_;
+
+				/** columns of the BALL descriptors, in the order of descriptors_ */
+				std::vector<Position> columns_;
+
+				/** columns and indices of the counted functional groups */
+				std::vector<std::pair<Position, Position> > functional_groups_;
+
+				/** descriptors of each thread */
+				std::vector<std::vector<Descriptor*> > descriptors_;
+
+				/** time spent on each descriptor (and on all functional groups) by each thread */
+				std::vector<std::vector<double> > timings_;
+
+				std::vector<Molecule*> reading_;
+
+				std::vector<Molecule*> running_;
+
+				/** row of the first molecule of the running chunk */
+				Position first_row_;
+
+				Size chunk_size_;
+
+				boost::thread_group* workers_;
+
+				boost::mutex error_mutex_;
+
+				bool failed_;
+
+				String error_name_;
+
+				String error_message_;
+				//@}
+		};
+	}
+}
+
+#endif // BALL_QSAR_DESCRIPTORPIPELINE_H
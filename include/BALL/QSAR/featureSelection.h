@@ -18,11 +18,13 @@
 #endif
 
 #include <set>
+#include <vector>
 
 namespace BALL 
 {
 	namespace QSAR
 	{
+		class IncrementalCrossValidation;
 
 		class BALL_EXPORT FeatureSelection
 		{
@@ -50,6 +52,7 @@ namespace BALL
 	
 				/** starts forward selection. \n
 				In order to evaluate how much a descriptor increases the accuracy of the model, cross-validation is started in each step using descriptor_matrix from class QSARData as data source.\n
+				The candidate descriptors of each step are evaluated by as many threads as set by Validation::setNumberOfThreads() for the model. MLR, RR and PLS models are cross-validated incrementally by default, see setIncrementalValidation().\n
 				@param optPar 1 : Model.optimizeParameters() is used to try to find the optimal parameters during *each* step of feature selection. \n
 				0: Model.optimizeParameters() is not used during feature selection*/
 				void forwardSelection(int k=4, bool optPar=0);
@@ -91,6 +94,10 @@ namespace BALL
 				/** Sets a cutoff value for feature selections. \n
 				If the preditive quality is increased by less than d after adding/removing a descriptor, feature selection is stopped. */
 				void setQualityIncreaseCutoff(double& d);
+
+				/** If set to true (default), forwardSelection(), backwardSelection() and stepwiseSelection() evaluate the candidate descriptors of MLR, RR and PLS models by IncrementalCrossValidation instead of training the model for each of them, unless the parameters of the model are to be optimized in each step. \n
+				The selected descriptors are the same, apart from rounding errors. */
+				void setIncrementalValidation(bool b);
 				//@}
 	
 	
@@ -100,6 +107,18 @@ namespace BALL
 				 */
 				//@{
 				void updateWeights(std::multiset<unsigned int>& oldDescIDs, std::multiset<unsigned int>& newDescIDs, Eigen::VectorXd& oldWeights);
+
+				/** returns an IncrementalCrossValidation object for the selected descriptors, or NULL if the candidates must be evaluated by training the model */
+				IncrementalCrossValidation* createIncrementalValidation(int k, bool optPar);
+
+				/** calculates the quality of cross-validation after adding (addition==1) or removing each of the given descriptors to/from the selected ones */
+				void evaluateCandidates(const std::vector<unsigned int>& candidates, bool addition, int k, bool optPar, IncrementalCrossValidation* incremental, std::multiset<unsigned int>& old_descriptors, Eigen::VectorXd& old_weights, std::vector<double>& qualities);
+
+				/** task for Validation::runTasks(), cross-validates the model of the given Validation object for one of the candidates */
+				static void evaluateCandidateTask(Validation* validation, Position candidate, const std::multiset<unsigned int>* descriptors, const std::vector<unsigned int>* candidates, bool addition, int k, bool optPar, std::vector<double>* qualities);
+
+				/** cross-validates the model (with optimization of its parameters if optPar==1) and returns the quality, or -infinity if the selected descriptors yield no PCA eigenvectors or a singular matrix, so that such candidates are ignored by any number of threads */
+				static double crossValidate(Model* model, int k, bool optPar);
 				//@}
 				
 				
@@ -121,6 +140,9 @@ namespace BALL
 				
 				/** if the preditive quality is increased by less than this value after adding/removing a descriptor, feature selection is stopped. */
 				double quality_increase_cutoff_;
+
+				/** use IncrementalCrossValidation, if possible */
+				bool incremental_;
 				//@}
 		};
 	}
@@ -0,0 +1,176 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+//
+
+#ifndef BALL_QSAR_INCREMENTALCROSSVALIDATION_H
+#define BALL_QSAR_INCREMENTALCROSSVALIDATION_H
+
+#ifndef BALL_QSAR_MODEL_H
+#include <BALL/QSAR/Model.h>
+#endif
+
+#include <set>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace BALL
+{
+	namespace QSAR
+	{
+		/** Cross-validates linear regression models (MLRModel, RRModel, PLSModel) for descriptor sets that differ from the currently selected one by a single descriptor, without training the model anew for each of them.\n
+		The substances are split into the same k folds as done by RegressionValidation::crossValidation(), so that the qualities (Q^2) calculated here are those that cross-validation of the model would yield, up to rounding errors.\n
+		For MLR and RR models, the upper triangular factor R of the normal equations R^T*R = X^T*X + lambda*I of the training data of each fold is kept, together with the projections of all descriptors and responses onto the selected descriptors. The quality after adding a descriptor is obtained from the rank-one bordering of R, the quality after removing a descriptor from the rank-one downdate of the inverse of the normal equations. Accepted changes are applied to R by bordering and by Givens rotations, respectively, so that the model is never trained from scratch.\n
+		PLS models do not solve the normal equations; for them, the cross-products X^T*X and X^T*Y of the training data of each fold are kept and bordered, and the PLS components are calculated from these cross-products (kernel algorithm) instead of from the training data. */
+		class BALL_EXPORT IncrementalCrossValidation
+		{
+			public:
+				/** @name Constructors and Destructors
+				 */
+				//@{
+				/** @param model the model whose data and parameters are used
+				@param k the number of folds of cross-validation
+				@param descriptors the IDs of the initially selected descriptors, i.e. columns of the data of the model
+				@throw Exception::InconsistentUsage if the model is not supported, see isSupported()
+				@throw Exception::SingularMatrixError if the normal equations of the selected descriptors are singular in any fold */
+				IncrementalCrossValidation(Model& model, int k, const std::multiset<unsigned int>& descriptors);
+
+				~IncrementalCrossValidation();
+
+				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+				//@}
+
+
+				/** @name Accessors
+				 */
+				//@{
+				/** returns true for MLR, RR and PLS models */
+				static bool isSupported(Model& model);
+
+				/** sets the number of threads that evaluate the candidates passed to testAdditions() and testRemovals() (default: 1) */
+				void setNumberOfThreads(Size number_of_threads);
+
+				Size getNumberOfThreads() const;
+
+				/** returns the IDs of the selected descriptors in the order of their selection */
+				const std::vector<unsigned int>& getSelectedDescriptors() const;
+
+				/** returns the quality of cross-validation for the selected descriptors */
+				double getQuality() const;
+
+				/** calculates the quality of cross-validation after adding each of the given (unselected) descriptors to the selected ones.\n
+				Descriptors that are linearly dependent on the selected ones and, for MLR models, descriptors that would leave fewer training substances than descriptors are given a quality of -infinity. */
+				void testAdditions(const std::vector<unsigned int>& candidates, std::vector<double>& qualities);
+
+				/** calculates the quality of cross-validation after removing each of the given (selected) descriptors */
+				void testRemovals(const std::vector<unsigned int>& candidates, std::vector<double>& qualities);
+
+				/** adds the given descriptor to the selected ones
+				@throw Exception::SingularMatrixError if the descriptor cannot be added, see testAdditions() */
+				void addDescriptor(unsigned int descriptor);
+
+				/** removes the given descriptor from the selected ones
+				@throw Exception::InconsistentUsage if the descriptor is not selected */
+				void removeDescriptor(unsigned int descriptor);
+				//@}
+
+
+			protected:
+
+				/** the data of one fold of cross-validation */
+				struct Fold
+				{
+					/** rows of the test substances */
+					std::vector<Position> test;
+
+					Size training_size;
+
+					/** descriptors and responses of the test substances */
+					Eigen::MatrixXd X_test;
+
+					Eigen::MatrixXd Y_test;
+
+					/** sum of squared deviations of the test responses from their means */
+					double ss_y;
+
+					/** x^T*x (+lambda) of the training data for each descriptor x */
+					Eigen::VectorXd squared_norms;
+
+					/** X^T*Y of the training data */
+					Eigen::MatrixXd XtY;
+
+					/** MLR, RR: the factor R of the normal equations of the selected descriptors */
+					Eigen::MatrixXd R;
+
+					/** MLR, RR: R^-T*X_s^T*X, the projections of all descriptors onto the selected ones */
+					Eigen::MatrixXd W;
+
+					/** MLR, RR: R^-T*X_s^T*Y, so that the coefficients of the model are R^-1*Z */
+					Eigen::MatrixXd Z;
+
+					/** MLR, RR: X_s*R^-1 for the test substances */
+					Eigen::MatrixXd T;
+
+					/** PLS: X_s^T*X of the training data */
+					Eigen::MatrixXd C;
+
+					/** predictions for the test substances by the selected descriptors */
+					Eigen::MatrixXd predictions;
+
+					/** data prepared for the evaluation of candidates; MLR, RR (removals only): V = R^-T, TV = T*V, VZ = V^T*Z; PLS: V = X_s^T*X_s, TV = X_s of the test substances, VZ = X_s^T*Y */
+					Eigen::MatrixXd V;
+
+					Eigen::MatrixXd TV;
+
+					Eigen::MatrixXd VZ;
+				};
+
+				/** calculates the quality of the given predictions for the test substances of a fold */
+				double calculateQuality(const Fold& fold, const Eigen::MatrixXd& predictions) const;
+
+				/** calculates the coefficients of a PLS model from the cross-products of its training data */
+				void calculatePLSCoefficients(const Eigen::MatrixXd& XtX, Eigen::MatrixXd XtY, Eigen::MatrixXd& coefficients) const;
+
+				/** sets Fold.V, Fold.TV and Fold.VZ for the selected descriptors */
+				void prepareFold(Fold& fold, bool removal);
+
+				/** calculates the predictions of the PLS model of the selected descriptors for the test substances of a fold */
+				void updatePLSPredictions(Fold& fold);
+
+				/** returns the position of the descriptor within selected_ or selected_.size() */
+				Position findSelected(unsigned int descriptor) const;
+
+				/** thread functions, evaluate the candidates first, first+step, ... */
+				void testAdditionsThread(const std::vector<unsigned int>* candidates, std::vector<double>* qualities, Position first, Size step) const;
+
+				void testRemovalsThread(const std::vector<unsigned int>* candidates, std::vector<double>* qualities, Position first, Size step) const;
+
+
+				/** @name Attributes
+				 */
+				//@{
+				/** descriptors and responses of all substances */
+				Eigen::MatrixXd X_;
+
+				Eigen::MatrixXd Y_;
+
+				std::vector<Fold> folds_;
+
+				std::vector<unsigned int> selected_;
+
+				bool pls_;
+
+				/** regularization parameter of RR models, 0 for MLR and PLS */
+				double lambda_;
+
+				/** number of PLS components */
+				Size no_components_;
+
+				Size number_of_threads_;
+				//@}
+		};
+	}
+}
+
+#endif // BALL_QSAR_INCREMENTALCROSSVALIDATION_H
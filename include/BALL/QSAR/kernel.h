@@ -22,6 +22,10 @@
 #include <BALL/QSAR/regressionModel.h>
 #endif
 
+#ifndef BALL_QSAR_KERNELEQUATION_H
+#include <BALL/QSAR/kernelEquation.h>
+#endif
+
 #include <cmath>
 #include <sstream>
 
@@ -55,13 +59,14 @@ namespace BALL
 				 */
 				//@{
 				/** calculates pairwise distances between all substances in Eigen::MatrixXd input and saves them to Eigen::MatrixXd output.\n
-				If Kernel.weights is not empty, function Kernel.calculateWeightedDistanceMatrix() is used \n 
+				If Kernel.type==5, the weighted distance \f$ \sum_{i=1}^m w_i * (input_{ai}- input_{bi})^{p} \f$ is used \n 
 				Else if: Kernel.f=="" and Kernel.g="", the distance between two substances a and b is calculated as \f$ \sum_{i=1}^m (input_{ai} * input_{bi})^p \f$, with m=\#descriptors  \n
-				Else: distance is calculated as \f$ g(\sum_{i=1}^m f(input_{ai}, input_{bi})) \f$*/
+				Else: distance is calculated as \f$ g(\sum_{i=1}^m f(input_{ai}, input_{bi})) \f$\n
+				Since the matrix is symmetric, only one triangle is calculated. */
 				void calculateKernelMatrix(Eigen::MatrixXd& input, Eigen::MatrixXd& output);
 				
 				/** calculates pairwise distance between all substances of m1 and m2 and saves them to Eigen::MatrixXd output. \n
-				If Kernel.weights is not empty, function Kernel.calculateWeightedDistanceMatrix() is used \n 
+				If Kernel.type==5, the weighted distance \f$ \sum_{i=1}^m w_i * (m1_{ai}- m2_{bi})^{p} \f$ is used \n 
 				Esle if: Kernel.f=="" and Kernel.g="", the distance between two substances a and b is calculated as \f$ \sum_{i=1}^m (m1_{ai} * m2_{bi})^p \f$, with m=\#descriptors \n
 				Else: distance is calculated as \f$ g(\sum_{i=1}^m f(m1_{ai}, m2_{bi})) \f$*/
 				void calculateKernelMatrix(Eigen::MatrixXd& K, Eigen::MatrixXd& m1, Eigen::MatrixXd& m2, Eigen::MatrixXd& output);
@@ -77,6 +82,12 @@ namespace BALL
 				@param steps the number of steps for grid search 
 				@param recursions number of recursions of grid search; in each recursion the step width is decreased by factor of 10 and searching is done in 20 steps around the values of the best kernel parameters determined in last recursion */
 				void gridSearch(double step_width, int steps, int recursions, int k, bool opt=0);
+
+				/** sets the number of threads used for the calculation of kernel matrices (default: 1). \n
+				The number of threads is not copied by KernelModel::operator=(), so that the models created by Validation::runTasks() calculate their kernel matrices sequentially. */
+				void setNumberOfThreads(Size number_of_threads);
+
+				Size getNumberOfThreads() const;
 				//@}
 				
 				
@@ -113,32 +124,21 @@ namespace BALL
 
 				void gridSearch(double step_width, int steps, bool first_rec, int k, double par1_start, double par2_start, bool opt);
 
-				/** calculates pairwise distances between all substances in Eigen::MatrixXd input, weighted by the contribution of every descriptor (as encoded in Kernel.weights), and saves them to Eigen::MatrixXd output.\n
-				Distance between two substances a and b is calculated as \f$ \sum_{i=1}^m w_i * (input_{ai}- input_{bi})^2 \f$, with m=\#descriptors */
-				void calculateWeightedKernelMatrix(Eigen::MatrixXd& input, Eigen::MatrixXd& output);
-				
-				
-				/** calculates pairwise distances between all substances of m1 and m2, weighted by the contribution of every descriptor (as encoded in Kernel.weights), and saves them to Eigen::MatrixXd output.\n
-				Distance between two substances a and b is calculated as \f$ \sum_{i=1}^m w_i * (m1_{ai}- m2_{bi})^2 \f$, with m=\#descriptors */
-				void calculateWeightedKernelMatrix(Eigen::MatrixXd& m1, Eigen::MatrixXd& m2, Eigen::MatrixXd& output);
-				
-				
-				void calculateKernelMatrix1(Eigen::MatrixXd& input, Eigen::MatrixXd& output);
-				
-				void calculateKernelMatrix2(Eigen::MatrixXd& input, Eigen::MatrixXd& output);
-				
-				void calculateKernelMatrix3(Eigen::MatrixXd& input, Eigen::MatrixXd& output);
-				
-				void calculateKernelMatrix4(Eigen::MatrixXd& input, Eigen::MatrixXd& output);
-				
-				
-				void calculateKernelMatrix1(Eigen::MatrixXd& m1, Eigen::MatrixXd& m2, Eigen::MatrixXd& output);
-				
-				void calculateKernelMatrix2(Eigen::MatrixXd& m1, Eigen::MatrixXd& m2, Eigen::MatrixXd& output);
-				
-				void calculateKernelMatrix3(Eigen::MatrixXd& m1, Eigen::MatrixXd& m2, Eigen::MatrixXd& output);
-				
-				void calculateKernelMatrix4(Eigen::MatrixXd& m1, Eigen::MatrixXd& m2, Eigen::MatrixXd& output);
+				/** sets the kernel parameters of the model of the given validation object to the given grid point and cross-validates the model */
+				static void gridSearchTask(Validation* validation, Position point, int k, bool opt, const std::vector<std::pair<double, double> >* grid, std::vector<double>* cv_results);
+
+				struct KernelMatrixData;
+
+				/** calculates the kernel matrix between all rows of m1 and all rows of m2 in blocks of rows, which are distributed over getNumberOfThreads() threads. \n
+				Polynomial, RBF, sigmoid and squared weighted distance kernels are derived from the matrix of scalar products, which is calculated block-wise by matrix products. 
+				@param symmetric if true, m1 and m2 must be the same matrix and only the upper triangle of output is calculated and then mirrored */
+				void calculateBlockedKernelMatrix(const Eigen::MatrixXd& m1, const Eigen::MatrixXd& m2, bool symmetric, Eigen::MatrixXd& output);
+
+				/** calculates the row blocks first, first+step, ... of the kernel matrix */
+				void calculateKernelBlocks(const KernelMatrixData* data, Position first, Size step, Eigen::MatrixXd* output) const;
+
+				/** calculates the rows row_begin to row_end-1 of the kernel matrix of an individual kernel-function or a weighted distance kernel with non-quadratic distances element by element */
+				void calculateKernelRows(const KernelMatrixData* data, Position row_begin, Position row_end, Position col_begin, Eigen::MatrixXd& output) const;
 				//@}
 				
 				
@@ -149,6 +149,8 @@ namespace BALL
 				Model* model_;
 				
 				Eigen::VectorXd weights_;
+
+				Size number_of_threads_;
 				//@}
 				
 				
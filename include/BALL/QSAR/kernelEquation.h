@@ -0,0 +1,138 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+//
+
+#ifndef BALL_QSAR_KERNELEQUATION_H
+#define BALL_QSAR_KERNELEQUATION_H
+
+#ifndef BALL_DATATYPE_STRING_H
+#include <BALL/DATATYPE/string.h>
+#endif
+
+#ifndef BALL_QSAR_EXCEPTION_H
+#include <BALL/QSAR/exception.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	namespace QSAR
+	{
+		/** Equation of an individual kernel function, compiled into a sequence of instructions.\n
+		The syntax is that of ParsedFunction: statements are separated by ';' or newlines and may assign variables,
+		e.g. "a=0.5; (x1-x2)^2*a". The value of the equation is the value of its last statement.
+		Supported are the operators +, -, *, / and ^, parentheses and the functions sin, cos, tan, asin, acos, atan, exp and ln.\n
+		In contrast to ParsedFunction, the equation is parsed only once and is evaluated for a whole block
+		of up to BLOCK_SIZE values of its variables at a time. Evaluation does not modify the equation, so one
+		KernelEquation may be used by several threads. */
+		class BALL_EXPORT KernelEquation
+		{
+			public:
+				/** @name Constructors and Destructors
+				 */
+				//@{
+				KernelEquation();
+
+				/** compiles the given equation, see compile() */
+				KernelEquation(const String& equation);
+
+				~KernelEquation();
+				//@}
+
+
+				/** @name Accessors
+				 */
+				//@{
+				/** the maximal number of values evaluated by one call of evaluate() */
+				static const Size BLOCK_SIZE;
+
+				/** compiles the given equation.
+				@throw Exception::KernelParameterError if the equation is not valid */
+				void compile(const String& equation);
+
+				const String& getEquation() const;
+
+				/** returns the number of variables used by the equation, including those assigned within the equation */
+				Size getNumberOfVariables() const;
+
+				/** returns the index of the variable with the given name, or -1 if the equation does not use it */
+				Index getVariable(const String& name) const;
+
+				/** returns the number of intermediate results needed for the evaluation */
+				Size getStackSize() const;
+
+				/** evaluates the equation for n<=BLOCK_SIZE values of its variables.
+				@param variables getNumberOfVariables()*BLOCK_SIZE values; the i-th value of variable v is variables[v*BLOCK_SIZE+i]. Variables assigned by the equation are overwritten.
+				@param stack storage for getStackSize()*BLOCK_SIZE intermediate results
+				@param result storage for the n results */
+				void evaluate(Size n, double* variables, double* stack, double* result) const;
+				//@}
+
+
+			protected:
+
+				enum Operation
+				{
+					CONSTANT,
+					LOAD,
+					STORE,
+					POP,
+					ADD,
+					SUBTRACT,
+					MULTIPLY,
+					DIVIDE,
+					NEGATE,
+					POWER,
+					SQUARE,
+					FUNCTION
+				};
+
+				struct Instruction
+				{
+					Operation operation;
+					Index argument;
+					double value;
+				};
+
+				/** @name Parsing
+				 */
+				//@{
+				void parseExpression();
+				void parseSum();
+				void parseProduct();
+				void parseUnary();
+				void parsePower();
+				void parsePrimary();
+
+				void readToken();
+				void addInstruction(Operation operation, Index argument=0, double value=0);
+				Index addVariable(const String& name);
+				void throwParseError(const String& message) const;
+				//@}
+
+
+				/** @name Attributes
+				 */
+				//@{
+				String equation_;
+
+				std::vector<Instruction> instructions_;
+
+				std::vector<String> variables_;
+
+				Size stack_size_;
+
+				/** the state of the parser */
+				Position position_;
+				String token_;
+				char token_type_;
+				double token_value_;
+				Size stack_depth_;
+				//@}
+		};
+	}
+}
+
+#endif // BALL_QSAR_KERNELEQUATION_H
@@ -45,6 +45,9 @@ namespace BALL
 				virtual void readFromFile(string filename);
 				
 				virtual Eigen::VectorXd predict(const vector<double>& substance, bool transform);
+
+				/** predicts the activities of all given substances by one matrix multiplication, using the threads of the kernel for the calculation of the kernel matrix */
+				virtual Eigen::MatrixXd predictBatch(const Eigen::MatrixXd& substances, bool transform=1);
 				
 				void operator=(const Model& m);
 
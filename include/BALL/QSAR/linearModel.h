@@ -36,6 +36,9 @@ namespace BALL
 				 */
 				//@{
 				virtual Eigen::VectorXd predict(const vector<double>& substance, bool transform=1);
+
+				/** predicts the activities of all given substances by one matrix multiplication */
+				virtual Eigen::MatrixXd predictBatch(const Eigen::MatrixXd& substances, bool transform=1);
 	
 			protected:
 				void calculateOffsets();
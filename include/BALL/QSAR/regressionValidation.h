@@ -136,6 +136,17 @@ namespace BALL
 					Eigen::MatrixXd loadings;
 					Eigen::MatrixXd weights;
 				};
+
+				/** the result of one fold, bootstrap sample or response permutation run, see Validation::runTasks() */
+				struct TaskResult
+				{
+					EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+					double quality;
+					double fit;
+					double max_error;
+					Eigen::MatrixXd training_result;
+				};
 				
 				
 				/** @name Accessors
@@ -147,6 +158,15 @@ namespace BALL
 				void backupTrainingResults();
 				
 				void restoreTrainingResults();
+
+				/** trains the model of the given validation object on all folds but the given one and tests it on this fold */
+				static void crossValidationTask(Validation* validation, Position fold, int k, bool store_training_result, vector<TaskResult>* results);
+
+				/** trains the model of the given validation object on the given bootstrap sample and tests it */
+				static void bootstrapTask(Validation* validation, Position sample, unsigned int seed, bool store_training_result, vector<TaskResult>* results);
+
+				/** randomizes the response values of the data of the given validation object and validates its model */
+				static void yRandomizationTask(Validation* validation, Position run, int k, unsigned int seed, const VMatrix* response_values, vector<TaskResult>* results);
 				//@}
 				
 				
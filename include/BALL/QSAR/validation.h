@@ -12,6 +12,8 @@
 
 #include <iterator>
 
+#include <boost/function.hpp>
+
 
 namespace BALL
 {	
@@ -77,6 +79,29 @@ namespace BALL
 				
 				/** restore validation-results from a file */
 				virtual void readFromFile(string filename) = 0;
+
+				/** returns the model that is validated by this object */
+				Model* getModel() const;
+
+				/** sets the number of threads that validate the folds of crossValidation(), the samples of bootstrap(), the runs of yRandomizationTest() and the grid points of Kernel::gridSearch() (default: 1).\n
+				If more than one thread is used, each thread validates its own copy of the model, so that the training data of the model itself is not changed by the validation. Models with a weighted distance kernel are always validated by one thread. */
+				void setNumberOfThreads(Size number_of_threads);
+
+				/** returns the number of threads used for validation */
+				Size getNumberOfThreads() const;
+
+				/** sets the seed of the random numbers of bootstrap() and yRandomizationTest(). \n
+				Sample resp. run i uses the seed seed+i, so that the results do not depend on the number of threads. If the seed is 0 (default), a new seed is taken from the current time for each validation. */
+				void setSeed(unsigned int seed);
+
+				/** returns the seed of the random numbers, see setSeed() */
+				unsigned int getSeed() const;
+
+				/** calls task(validation, i) for i=0,...,number_of_tasks-1, distributed over getNumberOfThreads() threads. \n
+				If only one thread is used, validation is this object. Otherwise every thread creates a copy of the model (see Model::operator=()) and passes the validation object of its copy, which uses only one thread itself.
+				@param copy_data if true, the copies of the model are bound to copies of the QSARData object, so that the tasks can change the data of their model without affecting each other
+				@throw BALL::Exception::GeneralException if a task failed in one of the threads */
+				void runTasks(Size number_of_tasks, const boost::function<void (Validation*, Position)>& task, bool copy_data = false);
 				//@}
 				
 				
@@ -92,8 +117,15 @@ namespace BALL
 				@param back_transform descriptor values are transformed back to in order to un-do centering */
 				void setTestLine(int test_line, int current_line, bool back_transform=0);
 				
-				/** randomizes all columns of Model.Y_ */
-				void yRand();
+				/** randomizes all columns of the response values of the QSARData object of the model
+				@param seed the seed of the random numbers */
+				void yRand(unsigned int seed);
+
+				/** returns the seed for the next validation, see setSeed() */
+				unsigned int drawSeed() const;
+
+				/** creates a copy of the model as described by Model::operator=() that is bound to the given data and validated by one thread */
+				Model* createModelCopy(const QSARData* data) const;
 				//@}
 				
 				
@@ -117,6 +149,12 @@ namespace BALL
 				int validation_statistic_;
 				
 				Eigen::MatrixXd yRand_results_;
+
+				/** the number of threads used for validation */
+				Size number_of_threads_;
+
+				/** the seed of the random numbers, 0 if it is to be taken from the current time */
+				unsigned int seed_;
 				//@}
 			
 		};
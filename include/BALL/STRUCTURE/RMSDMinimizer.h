@@ -24,6 +24,9 @@ namespace BALL
 			the RMSD-optimal transformation by solving an eigenvalue
 			problem.
 			 \par
+			To superpose many coordinate sets onto one reference, use
+			 \link BatchRMSDMinimizer BatchRMSDMinimizer \endlink.
+			 \par
 	\ingroup StructureMapping
 	*/
 	class BALL_EXPORT RMSDMinimizer
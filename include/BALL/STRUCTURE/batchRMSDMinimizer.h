@@ -0,0 +1,143 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_STRUCTURE_BATCHRMSDMINIMIZER_H
+#define BALL_STRUCTURE_BATCHRMSDMINIMIZER_H
+
+#ifndef BALL_STRUCTURE_RMSDMINIMIZER_H
+#	include <BALL/STRUCTURE/RMSDMinimizer.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	/** Superposition of many coordinate sets onto one reference.
+			This class computes the RMSD-optimal transformations mapping a large
+			number of coordinate sets (e.g. trajectory frames or docking poses)
+			onto a common reference, and the RMSDs after superposition. It uses
+			the quaternion characteristic polynomial (QCP) method (Theobald, Acta
+			Cryst. A61, 478 (2005); Liu et al., J. Comput. Chem. 31(7), 1561 (2010)):
+			the largest eigenvalue of the key matrix of  \link RMSDMinimizer RMSDMinimizer \endlink
+			is found by a Newton iteration on its characteristic polynomial, and
+			the rotation is only computed if it is requested.
+			\par
+			The coordinate sets are passed as packed float arrays: the x, y, and z
+			coordinates of all points of a set, followed by those of the next set.
+			A <tt>std::vector<Vector3></tt> has exactly this layout. The reference
+			is centered once, and the sets are distributed over several threads.
+			\par
+			The results agree with  \link RMSDMinimizer::computeTransformation RMSDMinimizer::computeTransformation \endlink
+			(with the set as first and the reference as second argument) up to
+			the precision of the float coordinates.
+			\par
+	\ingroup StructureMapping
+	*/
+	class BALL_EXPORT BatchRMSDMinimizer
+	{
+		public:
+
+		typedef RMSDMinimizer::PointVector PointVector;
+
+		/**	@name Constructors and Destructor
+		*/
+		//@{
+
+		/// Default constructor
+		BatchRMSDMinimizer();
+
+		/** Construct with a reference
+				@throw RMSDMinimizer::TooFewCoordinates if the reference contains less than three points
+		*/
+		BatchRMSDMinimizer(const PointVector& reference)
+			throw(RMSDMinimizer::TooFewCoordinates);
+
+		/// Destructor
+		virtual ~BatchRMSDMinimizer();
+
+		//@}
+		/**	@name Accessors
+		*/
+		//@{
+
+		/** Set the reference.
+				@throw RMSDMinimizer::TooFewCoordinates if the reference contains less than three points
+		*/
+		void setReference(const PointVector& reference)
+			throw(RMSDMinimizer::TooFewCoordinates);
+
+		/** Set the reference from a packed float array of <tt>3 * number_of_points</tt> coordinates.
+				@throw RMSDMinimizer::TooFewCoordinates if the reference contains less than three points
+		*/
+		void setReference(const float* coordinates, Size number_of_points)
+			throw(RMSDMinimizer::TooFewCoordinates);
+
+		/// Return the number of points of the reference (and of each coordinate set)
+		Size getNumberOfPoints() const { return number_of_points_; }
+
+		/// Set the number of threads (at least one)
+		void setNumberOfThreads(Size number_of_threads) { number_of_threads_ = std::max((Size)1, number_of_threads); }
+
+		/// Return the number of threads
+		Size getNumberOfThreads() const { return number_of_threads_; }
+
+		//@}
+		/**	@name Superposition
+		*/
+		//@{
+
+		/** Superpose packed coordinate sets onto the reference.
+				@param coordinates <tt>number_of_sets</tt> sets of <tt>3 * getNumberOfPoints()</tt> floats
+				@param rmsds an array of <tt>number_of_sets</tt> values receiving the RMSDs after superposition
+				@param transformations 0, or an array of <tt>number_of_sets</tt> transformations receiving
+				       the transformations that map each set onto the reference
+		*/
+		void superpose(const float* coordinates, Size number_of_sets,
+		               double* rmsds, Matrix4x4* transformations = 0) const;
+
+		/** Superpose coordinate sets onto the reference.
+				@param transformations 0, or a vector receiving the transformations that map each set onto the reference
+				@throw RMSDMinimizer::IncompatibleCoordinateSets if a set differs in size from the reference
+		*/
+		void superpose(const std::vector<PointVector>& sets, std::vector<double>& rmsds,
+		               std::vector<Matrix4x4>* transformations = 0) const
+			throw(RMSDMinimizer::IncompatibleCoordinateSets);
+
+		/** Superpose one coordinate set onto the reference.
+				@return the transformation mapping the set onto the reference and the RMSD
+				@throw RMSDMinimizer::IncompatibleCoordinateSets if the set differs in size from the reference
+		*/
+		RMSDMinimizer::Result computeTransformation(const PointVector& set) const
+			throw(RMSDMinimizer::IncompatibleCoordinateSets);
+
+		//@}
+
+		protected:
+
+		//_ Superpose the sets begin, ..., end - 1
+		void superposeRange_(const float* coordinates, Position begin, Position end,
+		                     double* rmsds, Matrix4x4* transformations) const;
+
+		//_ Superpose a single set
+		double superposeSet_(const float* coordinates, Matrix4x4* transformation) const;
+
+		//_ The number of points per set
+		Size number_of_points_;
+
+		//_ The centered reference coordinates
+		std::vector<double> reference_;
+
+		//_ The center of the reference
+		Vector3 reference_center_;
+
+		//_ The sum of the squared norms of the centered reference coordinates
+		double reference_inner_product_;
+
+		//_ The number of threads
+		Size number_of_threads_;
+	};
+
+}	// namespace BALL
+
+#endif // BALL_STRUCTURE_BATCHRMSDMINIMIZER_H
@@ -13,6 +13,10 @@
 #       include <BALL/DATATYPE/options.h>
 #endif
 
+#ifndef BALL_STRUCTURE_PACKEDFINGERPRINT_H
+#       include <BALL/STRUCTURE/packedFingerprint.h>
+#endif
+
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_traits.hpp>
@@ -27,6 +31,15 @@
 #include <vector>
 
 
+namespace boost
+{
+	namespace iostreams
+	{
+		class mapped_file;
+	}
+}
+
+
 namespace BALL 
 {
 	/** 	Binary Fingerprint Methods
@@ -35,7 +48,8 @@ namespace BALL
 		BinaryFingerprintMethods uses a blocked inverted index data structures as a representation of 2D binary fingerprints.
 		This data structure enables efficient calculation of similarity coefficients which use shared feature counts
 		between two fingerprints. The shared feature count is the number of on-bits which two different fingerprints have
-		in common. Currently the class provides the Tanimoto coefficient. \n \n
+		in common. Currently the class provides the Tanimoto coefficient. For dense fingerprints, whose molecules share most of their
+		features, the all-pairs calculations use blocks of packed bitsets and population counts instead (see Option::DENSITY_CUTOFF). \n \n
 		Based on this similarity algorithm the class provides different useful public methods: \n
 		\link BinaryFingerprintMethods::cutoffSearch Cutoff Search \endlink: \n
 		Similarities of all molecules in a query library to all molecules in a target library are calculated and the pairs whose similarities
@@ -55,6 +69,9 @@ namespace BALL
 		the \link BinaryFingerprintMethods::NNChainCore Nearest Neighbour Chain algorithm \endlink is used. \n 
 		Finally, the method of \link BinaryFingerprintMethods::clusterSelectionKGS Kelly et al. \endlink is used to select an level for cluster selection 
 		and the created clusters are returned. \n
+		\link BinaryFingerprintMethods::connectedComponentsClustering Component-wise Clustering \endlink: \n
+		Libraries too large for a single hierarchical clustering are first decomposed into connected components, which are then clustered
+		independently and in parallel. The similarity matrices of the clustering may be stored in memory mapped scratch files. \n
 		\link BinaryFingerprintMethods::calculateSelectionMedoid Calculate Medoid \endlink : \n
 		For a set of input molecules the Medoid is calculated. The medoid is the molecule with the highest averaged similarity to all other molecules.
 		Additionally, the method returns the averaged pairwise similarities for every molecule in the input set. \n \n
@@ -128,6 +145,21 @@ namespace BALL
 				 * Intensity level of verbose output
 				 */
 				static const String VERBOSITY;
+				
+				/**
+				 * Fingerprint density (average number of features per molecule divided by the highest feature ID) from which on
+				 * shared feature counts of all molecule pairs are calculated from dense bitsets instead of inverted indices.
+				 * This applies to cutoffSearch, connectedComponents, calculateSelectionMedoid and the similarity matrix of the clustering.
+				 * A value of 0 always selects the dense bitsets, values above 1 never. The default of 0.2 is the break-even point
+				 * of the portable population count; builds with a hardware population count (e.g. -mpopcnt) profit from about 0.1 on.
+				 */
+				static const String DENSITY_CUTOFF;
+				
+				/**
+				 * Directory for scratch files. If set, the similarity half-matrices of the clustering step are stored in
+				 * memory mapped files in this directory instead of main memory. By default empty, i.e. matrices are kept in main memory.
+				 */
+				static const String SCRATCH_DIRECTORY;
 			};
 			
 			/**
@@ -142,6 +174,8 @@ namespace BALL
 				static const bool STORE_NN;
 				static const unsigned int N_THREADS;
 				static const int VERBOSITY;
+				static const float DENSITY_CUTOFF;
+				static const String SCRATCH_DIRECTORY;
 			};
 			
 			
@@ -209,6 +243,7 @@ namespace BALL
 			/** 
 			 * Wrapper for different binary fingerprint parsers which returns a vector of integer features.
 			 * The returned features lie in the interval [1, max_feature_id + 1]. Thus, no feature has ID = 0 which is important for inverted index implementation.
+			 * The features are returned in strictly decreasing order, i.e. feature lists are sorted and duplicate features are removed.
 			 * @param fprint The fingerprint as a separated list of integer features.
 			 * @param features A vector reference to return the fingerprint features. The vector will be cleaned first.
 			 * @param fp_type Fingerprint encoding: 1 = Binary Bitstring, 2 = Separated list of integer features
@@ -311,6 +346,26 @@ namespace BALL
 						      std::map<unsigned int, std::vector<unsigned int> >& cluster_selection);
 			
 			
+			/** 
+			 * Average linkage clustering of a set of molecules which is too large to be clustered as a whole.
+			 * The molecules are first decomposed into the connected components of their similarity network (see connectedComponents).
+			 * Every component with more than size_cutoff members is then clustered separately by averageLinkageClustering, smaller
+			 * components form a single cluster each. Components with more than MAX_CLUSTERS members are clustered one after another
+			 * using all threads, the remaining ones in parallel using one thread each. If Option::SCRATCH_DIRECTORY is set, the
+			 * similarity matrices of the clustering are stored in memory mapped files.
+			 * @param selection Indices of molecules in lib_features_ vector which should be clustered.
+			 * @param cutoff Similarity cutoff for the connected components decomposition.
+			 * @param size_cutoff Components with at most size_cutoff members are not clustered hierarchically.
+			 * @param cluster_selection Final clustering, i.e. the positions in selection of the members of every cluster. Cluster IDs are
+			 * consecutive over all components, which are numbered in the order returned by connectedComponents.
+			 * @return True if clustering was successful, false otherwise.
+			 */
+			bool connectedComponentsClustering(const std::vector<unsigned int>& selection, 
+							   const float cutoff, 
+							   const unsigned int size_cutoff, 
+							   std::map<unsigned int, std::vector<unsigned int> >& cluster_selection);
+			
+			
 			/** 
 			 * Calculation of the medoid of a set of molecules defined by selection. Medoid has the highest average similarity to all other compounds.
 			 * @param selection Indices of molecules in lib_features_ vector for which the medoid should be calculated.
@@ -644,6 +699,54 @@ namespace BALL
 			unsigned int max_clusters_;
 			
 			
+			/**
+			 * Fingerprint density from which on dense bitsets are used.
+			 */
+			float density_cutoff_;
+			
+			
+			/**
+			 * If true, InvertedIndices are created without FeatureLists and shared feature counts are calculated from dense_lib_ and dense_query_.
+			 */
+			bool dense_backend_;
+			
+			
+			/**
+			 * Number of words of a single dense bitset.
+			 */
+			unsigned int dense_words_;
+			
+			
+			/**
+			 * Dense bitsets of library molecules, dense_words_ words per molecule in the order of lib_iindices_.
+			 */
+			std::vector<PackedFingerprint::Word> dense_lib_;
+			
+			
+			/**
+			 * Dense bitsets of query molecules, dense_words_ words per molecule in the order of query_iindices_.
+			 */
+			std::vector<PackedFingerprint::Word> dense_query_;
+			
+			
+			/**
+			 * Directory for memory mapped similarity matrices. Empty if matrices are kept in main memory.
+			 */
+			String scratch_directory_;
+			
+			
+			/**
+			 * Memory mapped file which stores sim_matrix_. NULL if sim_matrix_ is kept in main memory.
+			 */
+			boost::iostreams::mapped_file* sim_matrix_file_;
+			
+			
+			/**
+			 * Name of the file mapped by sim_matrix_file_.
+			 */
+			String sim_matrix_file_name_;
+			
+			
 			/**
 			 * Setup routine.
 			 * @param options User defined options to overwrite default settings.
@@ -665,6 +768,50 @@ namespace BALL
 			void assign(const BinaryFingerprintMethods& bfm);
 			
 			
+			/**
+			 * Allocates sim_matrix_, in a memory mapped file in scratch_directory_ if set, otherwise in main memory.
+			 * @param size Number of matrix elements.
+			 */
+			void createSimilarityMatrix(const LongSize size);
+			
+			
+			/**
+			 * Deallocates sim_matrix_ and removes its scratch file.
+			 */
+			void destroySimilarityMatrix();
+			
+			
+			/**
+			 * Average linkage clustering of a single connected component.
+			 * @param selection Indices of molecules in lib_features_ as passed to connectedComponentsClustering.
+			 * @param component Positions of the component members in selection.
+			 * @param nn_data Nearest neighbour information of the component members as returned by connectedComponents. Vector is finally empty.
+			 * @param cluster_selection Final clustering of the component, i.e. the positions in selection of the members of every cluster.
+			 */
+			void clusterComponent(const std::vector<unsigned int>& selection, 
+			                      const std::vector<unsigned int>& component, 
+			                      std::vector<std::pair<unsigned int, float> >& nn_data, 
+			                      std::map<unsigned int, std::vector<unsigned int> >& cluster_selection);
+			
+			
+			/**
+			 * Thread routine to cluster connected components. Every thread uses a copy of this object with a single thread
+			 * and takes the next component from components until all of them have been clustered.
+			 * @param selection Indices of molecules in lib_features_ as passed to connectedComponentsClustering.
+			 * @param ccs Connected components.
+			 * @param nn_data Nearest neighbour information of the connected components.
+			 * @param components Indices into ccs of the components to cluster.
+			 * @param next_component Shared position of the next component to cluster in components.
+			 * @param results Clusterings of the components.
+			 */
+			void componentClusteringThread(const std::vector<unsigned int>* selection, 
+			                               const std::vector<std::vector<unsigned int> >* ccs, 
+			                               std::vector<std::vector<std::pair<unsigned int, float> > >* nn_data, 
+			                               const std::vector<unsigned int>* components, 
+			                               unsigned int* next_component, 
+			                               std::vector<std::map<unsigned int, std::vector<unsigned int> > >* results);
+			
+			
 			/**
 			 * Check if input data (lib_features_ and selection) are valid. 
 			 * @param selection Indices to molecule feature vectors in lib_features_ which should be checked.
@@ -798,6 +945,40 @@ namespace BALL
 			void calculateCommonCounts_M_N(const InvertedIndex* ii_1, const InvertedIndex* ii_2, unsigned short** cc_matrix);
 			
 			
+			/**
+			 * Select dense bitsets or inverted indices for the shared feature count calculation of two sets of molecules
+			 * by comparing their fingerprint density with density_cutoff_. Sets dense_backend_ and dense_words_.
+			 * @param molecules_1 Pairs of pointers to feature vectors and cluster IDs of the first set.
+			 * @param molecules_2 Pairs of pointers to feature vectors and cluster IDs of the second set.
+			 */
+			void selectBackend(const std::vector<std::pair<const std::vector<unsigned short>*, unsigned int> >& molecules_1, 
+			                   const std::vector<std::pair<const std::vector<unsigned short>*, unsigned int> >& molecules_2);
+			
+			
+			/**
+			 * Create dense bitsets of dense_words_ words for a set of molecules. Feature f sets bit f-1.
+			 * @param molecules Pairs of pointers to feature vectors and cluster IDs.
+			 * @param target Reference to vector to store the bitsets (either dense_lib_ or dense_query_).
+			 */
+			void createDenseBitsets(const std::vector<std::pair<const std::vector<unsigned short>*, unsigned int> >& molecules, 
+			                        std::vector<PackedFingerprint::Word>& target) const;
+			
+			
+			/**
+			 * Shared feature count calculation from dense bitsets of two blocks.
+			 * In contrast to calculateCommonCounts_M_N, cc_matrix does not need to be reset before.
+			 * @param block_1 Dense bitsets of the first block.
+			 * @param n_molecules_1 Number of molecules in the first block.
+			 * @param block_2 Dense bitsets of the second block.
+			 * @param n_molecules_2 Number of molecules in the second block.
+			 * @param strict_upper If true, both blocks are identical and only pairs u < v are calculated.
+			 * @param cc_matrix 2D integer array which finally stores the number of shared features of (block_1 X block_2).
+			 */
+			void calculateCommonCountsDense(const PackedFingerprint::Word* block_1, const unsigned int n_molecules_1, 
+			                                const PackedFingerprint::Word* block_2, const unsigned int n_molecules_2, 
+			                                const bool strict_upper, unsigned short** cc_matrix) const;
+			
+			
 			/**
 			 * Calculation of similarity coefficients and writing of similarities above cutoff to outfile.
 			 * @param query_index Position of InvertedIndex in query_iindices_.
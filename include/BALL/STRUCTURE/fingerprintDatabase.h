@@ -0,0 +1,222 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_STRUCTURE_FINGERPRINTDATABASE_H
+#define BALL_STRUCTURE_FINGERPRINTDATABASE_H
+
+#ifndef BALL_STRUCTURE_PACKEDFINGERPRINT_H
+#	include <BALL/STRUCTURE/packedFingerprint.h>
+#endif
+
+#ifndef BALL_DATATYPE_STRING_H
+#	include <BALL/DATATYPE/string.h>
+#endif
+
+#include <vector>
+
+namespace boost
+{
+	namespace iostreams
+	{
+		class mapped_file_source;
+	}
+}
+
+namespace BALL
+{
+	/** Memory mapped database of binary fingerprints.
+			A fingerprint database file stores a library of  \link PackedFingerprint packed fingerprints \endlink
+			of equal width together with their identifiers. It is written once by
+			\link FingerprintDatabase::write write \endlink and then opened read-only
+			as a memory mapped file, so that opening it takes constant time and the
+			operating system caches it between runs.
+			\par
+			The fingerprints are stored sorted by their number of set bits, with an
+			index to the first fingerprint of every bit count. The Tanimoto coefficient
+			of two fingerprints with <tt>a</tt> and <tt>b</tt> set bits is at most
+			<tt>min(a, b) / max(a, b)</tt> (Swamidass and Baldi, J. Chem. Inf. Model. 47, 302 (2007)),
+			so a search only visits the bit counts whose bound reaches the cutoff, or
+			for top-k searches the current k-th best similarity, in the order of
+			decreasing bound. A single query is split over several threads, a batch of
+			queries is distributed over the threads query by query.
+			\par
+			Search results refer to the fingerprints by their position in the
+			library passed to \link FingerprintDatabase::write write \endlink.
+			\par
+			The file stores the fingerprint words in the byte order of the machine
+			that wrote it; files of the other byte order are rejected by open().
+			\par
+	\ingroup StructureMiscellaneous
+	*/
+	class BALL_EXPORT FingerprintDatabase
+	{
+		public:
+
+		/// A search result
+		struct BALL_EXPORT Hit
+		{
+			/// The position of the fingerprint in the library
+			Position index;
+
+			/// The Tanimoto coefficient to the query
+			float similarity;
+		};
+
+		/// The version of the file format
+		static const Size VERSION;
+
+		/**	@name Constructors and Destructor
+		*/
+		//@{
+
+		/// Default constructor
+		FingerprintDatabase();
+
+		/** Constructor, opens a database file.
+				@throw Exception::FileNotFound if the file cannot be opened as a fingerprint database
+		*/
+		FingerprintDatabase(const String& filename)
+			throw(Exception::FileNotFound);
+
+		/// Destructor, closes the file
+		virtual ~FingerprintDatabase();
+
+		//@}
+		/**	@name Writing
+		*/
+		//@{
+
+		/** Write a library of fingerprints to a database file.
+				@param fingerprints the fingerprints, all of the same width
+				@param identifiers one identifier per fingerprint, or none
+				@return false if the file cannot be written or the arguments are inconsistent
+		*/
+		static bool write(const String& filename, const std::vector<PackedFingerprint>& fingerprints,
+		                  const std::vector<String>& identifiers);
+
+		//@}
+		/**	@name Accessors
+		*/
+		//@{
+
+		/** Open a database file.
+				@return false if the file cannot be mapped or is not a fingerprint database of this version
+		*/
+		bool open(const String& filename);
+
+		/// Close the file
+		void close();
+
+		/// Return true if a database is open
+		bool isOpen() const { return mapped_file_ != 0; }
+
+		/// Return the number of fingerprints
+		Size getNumberOfFingerprints() const { return number_of_fingerprints_; }
+
+		/// Return the width of the fingerprints in bits
+		Size getNumberOfBits() const { return number_of_bits_; }
+
+		/** Return the fingerprint at position <tt>index</tt> of the library
+				@throw Exception::IndexOverflow if <tt>index</tt> is not less than getNumberOfFingerprints()
+		*/
+		PackedFingerprint getFingerprint(Position index) const
+			throw(Exception::IndexOverflow);
+
+		/** Return the identifier of the fingerprint at position <tt>index</tt> of the library
+				@throw Exception::IndexOverflow if <tt>index</tt> is not less than getNumberOfFingerprints()
+		*/
+		String getIdentifier(Position index) const
+			throw(Exception::IndexOverflow);
+
+		/// Set the number of threads (at least one)
+		void setNumberOfThreads(Size number_of_threads) { number_of_threads_ = std::max((Size)1, number_of_threads); }
+
+		/// Return the number of threads
+		Size getNumberOfThreads() const { return number_of_threads_; }
+
+		//@}
+		/**	@name Similarity search
+				The query may be wider than the fingerprints of the database; its
+				additional bits count as unmatched. Hits are sorted by decreasing
+				similarity and increasing index.
+		*/
+		//@{
+
+		/// Find all fingerprints with a Tanimoto coefficient of at least <tt>cutoff</tt> to the query
+		void cutoffSearch(const PackedFingerprint& query, float cutoff, std::vector<Hit>& hits) const;
+
+		/// Find the <tt>k</tt> most similar fingerprints with a Tanimoto coefficient of at least <tt>cutoff</tt>
+		void topKSearch(const PackedFingerprint& query, Size k, std::vector<Hit>& hits, float cutoff = 0.0f) const;
+
+		/// Cutoff search for a batch of queries
+		void cutoffSearch(const std::vector<PackedFingerprint>& queries, float cutoff,
+		                  std::vector<std::vector<Hit> >& hits) const;
+
+		/// Top-k search for a batch of queries
+		void topKSearch(const std::vector<PackedFingerprint>& queries, Size k,
+		                std::vector<std::vector<Hit> >& hits, float cutoff = 0.0f) const;
+
+		//@}
+
+		protected:
+
+		//_ Search the part-th of number_of_parts slices of every bit count; k = 0 means cutoff search
+		void searchPart_(const PackedFingerprint* query, float cutoff, Size k,
+		                 Position part, Size number_of_parts, std::vector<Hit>* hits) const;
+
+		//_ Search one query, split over number_of_parts threads
+		void search_(const PackedFingerprint& query, float cutoff, Size k,
+		             Size number_of_parts, std::vector<Hit>& hits) const;
+
+		//_ Search the queries first, first + step, ... one after another
+		void searchQueries_(const std::vector<PackedFingerprint>* queries, float cutoff, Size k,
+		                    Position first, Size step, std::vector<std::vector<Hit> >* hits) const;
+
+		//_ Search a batch of queries
+		void searchBatch_(const std::vector<PackedFingerprint>& queries, float cutoff, Size k,
+		                  std::vector<std::vector<Hit> >& hits) const;
+
+		//_
+		boost::iostreams::mapped_file_source* mapped_file_;
+
+		//_
+		Size number_of_fingerprints_;
+
+		//_
+		Size number_of_bits_;
+
+		//_
+		Size number_of_words_;
+
+		//_ The first record of every bit count, number_of_bits_ + 2 entries
+		const LongSize* count_offsets_;
+
+		//_ The fingerprint words of the records, sorted by bit count
+		const PackedFingerprint::Word* words_;
+
+		//_ The library position of every record
+		const Size* record_indices_;
+
+		//_ The record of every library position
+		const Size* record_positions_;
+
+		//_ The offsets of the identifiers, number_of_fingerprints_ + 1 entries
+		const LongSize* identifier_offsets_;
+
+		//_ The characters of the identifiers
+		const char* identifiers_;
+
+		//_
+		Size number_of_threads_;
+
+		private:
+
+		FingerprintDatabase(const FingerprintDatabase&);
+
+		FingerprintDatabase& operator = (const FingerprintDatabase&);
+	};
+
+}	// namespace BALL
+
+#endif // BALL_STRUCTURE_FINGERPRINTDATABASE_H
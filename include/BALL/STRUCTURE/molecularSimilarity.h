@@ -19,6 +19,7 @@
 #endif
 
 #include <BALL/STRUCTURE/smartsMatcher.h>
+#include <BALL/STRUCTURE/packedFingerprint.h>
 #include <BALL/KERNEL/system.h>
 
 #ifdef BALL_HAS_OPENBABEL
@@ -32,6 +33,16 @@ namespace BALL
 	{
 		public:
 
+			/** Types of packed fingerprints
+			*/
+			enum FingerprintType
+			{
+				/// hashed linear paths, see generatePathFingerprint(const Molecule&, PackedFingerprint&, Size, Size)
+				PATH_FINGERPRINT,
+				/// hashed circular atom environments, see generateCircularFingerprint
+				CIRCULAR_FINGERPRINT
+			};
+
 			MolecularSimilarity(String smarts_file);
 
 			void generateFingerprints(System& molecules, vector<vector<Size> >& fingerprints);
@@ -66,6 +77,40 @@ namespace BALL
 			/** Calculate Tanimoto coefficient for two given binary fingerprints. */
 			float calculateSimilarity(vector<bool>& fingerprint1, vector<bool>& fingerprint2);
 
+			/** Generate a packed path fingerprint.
+			All linear paths of heavy atoms containing at most <tt>max_path_length</tt> bonds
+			(every bond at most once) are hashed from their element and bond order sequence,
+			independent of the direction in which they are traversed, and the corresponding
+			bits are set. Hydrogen atoms are ignored.
+			The enumeration works on a compact copy of the molecular graph with fixed-size
+			stacks and does not allocate memory per path.
+			@param number_of_bits the width of the fingerprint */
+			static void generatePathFingerprint(const Molecule& mol, PackedFingerprint& fingerprint,
+			                                    Size max_path_length = 7, Size number_of_bits = 1024);
+
+			/** Generate a packed circular fingerprint (ECFP-like).
+			Each heavy atom starts with an identifier hashed from its element, number of heavy
+			neighbours, number of hydrogens, formal charge and aromaticity. In each of <tt>radius</tt>
+			iterations the identifier is rehashed together with the sorted bond orders and
+			identifiers of the neighbours. A bit is set for every identifier of every iteration.
+			@param number_of_bits the width of the fingerprint */
+			static void generateCircularFingerprint(const Molecule& mol, PackedFingerprint& fingerprint,
+			                                        Size radius = 2, Size number_of_bits = 1024);
+
+			/** Generate packed fingerprints for many molecules.
+			The molecules are distributed over <tt>number_of_threads</tt> threads.
+			@param depth the maximal path length for PATH_FINGERPRINT, the radius for CIRCULAR_FINGERPRINT */
+			static void generateFingerprints(const vector<const Molecule*>& molecules, vector<PackedFingerprint>& fingerprints,
+			                                 FingerprintType type, Size depth, Size number_of_bits, Size number_of_threads = 1);
+
+			/** Calculate the Tanimoto coefficient of two packed fingerprints. */
+			static float calculateSimilarity(const PackedFingerprint& fingerprint1, const PackedFingerprint& fingerprint2);
+
+			/** Calculate the Tversky coefficient of two packed fingerprints.
+			@see PackedFingerprint::computeTversky */
+			static float calculateTverskySimilarity(const PackedFingerprint& fingerprint1, const PackedFingerprint& fingerprint2,
+			                                        float alpha, float beta);
+
 			void filterRedundantMolecules(const list<Molecule*>& molecules, float similarity_threshold);
 
 			void filterRedundantMolecules(System& molecules, float similarity_threshold);
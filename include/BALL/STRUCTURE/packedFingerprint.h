@@ -0,0 +1,184 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_STRUCTURE_PACKEDFINGERPRINT_H
+#define BALL_STRUCTURE_PACKEDFINGERPRINT_H
+
+#ifndef BALL_COMMON_H
+#	include <BALL/common.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	/** Fixed-width binary fingerprint packed into 64 bit words.
+			Bit <tt>i</tt> of the fingerprint is bit <tt>i % 64</tt> of word <tt>i / 64</tt>.
+			Unused bits of the last word are always zero, so that the bit counts
+			needed for similarity coefficients reduce to population counts over
+			whole words. Fingerprints of this type are generated by
+			\link MolecularSimilarity::generatePathFingerprint MolecularSimilarity \endlink.
+			\par
+			The static word-level functions operate on raw word arrays and may be
+			used for fingerprints stored elsewhere, e.g. in a memory mapped file.
+			\par
+	\ingroup StructureMiscellaneous
+	*/
+	class BALL_EXPORT PackedFingerprint
+	{
+		public:
+
+		/// The type of a fingerprint word
+		typedef LongSize Word;
+
+		/// The number of bits per word
+		static const Size BITS_PER_WORD;
+
+		/**	@name Constructors and Destructor
+		*/
+		//@{
+
+		/// Default constructor, creates a fingerprint without bits
+		PackedFingerprint();
+
+		/// Create a fingerprint of <tt>number_of_bits</tt> cleared bits
+		explicit PackedFingerprint(Size number_of_bits);
+
+		/// Destructor
+		virtual ~PackedFingerprint();
+
+		//@}
+		/**	@name Accessors
+		*/
+		//@{
+
+		/// Resize the fingerprint to <tt>number_of_bits</tt> bits and clear all bits
+		void resize(Size number_of_bits);
+
+		/// Clear all bits
+		void clear();
+
+		/** Copy <tt>number_of_bits</tt> bits from an array of words.
+				Bits of the last word beyond <tt>number_of_bits</tt> are cleared.
+		*/
+		void assign(const Word* words, Size number_of_bits);
+
+		/** Set the bits of a list of integer features.
+				The features are numbered from 1 as returned by
+				\link BinaryFingerprintMethods::parseBinaryFingerprint BinaryFingerprintMethods::parseBinaryFingerprint \endlink,
+				feature <tt>f</tt> sets bit <tt>f - 1</tt>. The fingerprint is resized to
+				<tt>min_number_of_bits</tt> bits, or to the smallest multiple of 64 bits
+				holding all features if that is larger.
+		*/
+		void setFeatures(const std::vector<unsigned short>& features, Size min_number_of_bits = 0);
+
+		/// Return the number of bits
+		Size getNumberOfBits() const { return number_of_bits_; }
+
+		/// Return the number of words
+		Size getNumberOfWords() const { return (Size)words_.size(); }
+
+		/// Set bit <tt>i</tt>; <tt>i</tt> must be less than getNumberOfBits()
+		void setBit(Position i) { words_[i / 64] |= (Word)1 << (i % 64); }
+
+		/// Return bit <tt>i</tt>; <tt>i</tt> must be less than getNumberOfBits()
+		bool getBit(Position i) const { return ((words_[i / 64] >> (i % 64)) & 1) != 0; }
+
+		/// Return the words, or 0 if the fingerprint has no bits
+		const Word* getWords() const { return words_.empty() ? 0 : &words_[0]; }
+
+		/// Return the number of set bits
+		Size countBits() const;
+
+		/// Equality
+		bool operator == (const PackedFingerprint& fingerprint) const;
+
+		/// Inequality
+		bool operator != (const PackedFingerprint& fingerprint) const { return !(*this == fingerprint); }
+
+		//@}
+		/**	@name Similarity coefficients
+				Fingerprints of different width are not comparable; the coefficients
+				are computed over the words of the shorter one.
+		*/
+		//@{
+
+		/** Return the Tanimoto coefficient <tt>c / (a + b - c)</tt>, where <tt>a</tt> and
+				<tt>b</tt> are the numbers of set bits and <tt>c</tt> the number of common
+				set bits. Two fingerprints without set bits have similarity zero.
+		*/
+		float computeTanimoto(const PackedFingerprint& fingerprint) const;
+
+		/** Return the Tversky coefficient <tt>c / (alpha * (a - c) + beta * (b - c) + c)</tt>,
+				where <tt>a</tt> refers to this fingerprint and <tt>b</tt> to the argument.
+				<tt>alpha = beta = 1</tt> yields the Tanimoto coefficient, <tt>alpha = beta = 0.5</tt>
+				the Dice coefficient.
+		*/
+		float computeTversky(const PackedFingerprint& fingerprint, float alpha, float beta) const;
+
+		//@}
+		/**	@name Word-level functions
+		*/
+		//@{
+
+		/// Return the number of set bits of a word
+		static Size countBits(Word word)
+		{
+			#if defined(__GNUC__) && defined(__POPCNT__)
+				return (Size)__builtin_popcountll(word);
+			#else
+				word = word - ((word >> 1) & 0x5555555555555555ULL);
+				word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+				word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+				return (Size)((word * 0x0101010101010101ULL) >> 56);
+			#endif
+		}
+
+		/// Return the number of set bits of <tt>number_of_words</tt> words
+		static Size countBits(const Word* words, Size number_of_words)
+		{
+			Size count = 0;
+			for (Position i = 0; i < number_of_words; ++i)
+			{
+				count += countBits(words[i]);
+			}
+			return count;
+		}
+
+		/// Return the number of bits set in both <tt>a</tt> and <tt>b</tt>
+		static Size countCommonBits(const Word* a, const Word* b, Size number_of_words)
+		{
+			Size count = 0;
+			for (Position i = 0; i < number_of_words; ++i)
+			{
+				count += countBits(a[i] & b[i]);
+			}
+			return count;
+		}
+
+		/** Return the Tanimoto coefficient from the bit counts.
+				@param count_a the number of set bits of the first fingerprint
+				@param count_b the number of set bits of the second fingerprint
+				@param common the number of common set bits
+		*/
+		static float computeTanimoto(Size count_a, Size count_b, Size common)
+		{
+			Size united = count_a + count_b - common;
+			return (united == 0) ? 0.0f : (float)common / (float)united;
+		}
+
+		//@}
+
+		protected:
+
+		//_ The number of bits
+		Size number_of_bits_;
+
+		//_ The words
+		std::vector<Word> words_;
+	};
+
+}	// namespace BALL
+
+#endif // BALL_STRUCTURE_PACKEDFINGERPRINT_H
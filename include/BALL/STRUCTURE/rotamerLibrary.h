@@ -32,6 +32,8 @@ namespace BALL
 	*/
 	class BALL_EXPORT RotamerLibrary
 	{
+		friend class RotamerTable;
+
 		public:
 
 		BALL_CREATE(RotamerLibrary)
@@ -0,0 +1,221 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_STRUCTURE_ROTAMERTABLE_H
+#define BALL_STRUCTURE_ROTAMERTABLE_H
+
+#ifndef BALL_STRUCTURE_RESIDUEROTAMERSET_H
+	#include <BALL/STRUCTURE/residueRotamerSet.h>
+#endif
+
+#ifndef BALL_DATATYPE_STRINGHASHMAP_H
+	#include <BALL/DATATYPE/stringHashMap.h>
+#endif
+
+#include <vector>
+
+namespace BALL
+{
+	class FragmentDB;
+	class Residue;
+	class RotamerLibrary;
+
+	/** @brief Compact read-only rotamer table.
+
+		\ingroup StructureRotamers
+		A flat representation of a \link RotamerLibrary RotamerLibrary \endlink
+		intended for fast lookups. For every residue type, the rotamers of all
+		phi/psi bins are stored in one dense bin array, the probabilities and
+		\f$\chi\f$ angles of all rotamers in contiguous arrays. A lookup is a
+		hash map access for the residue name (or none, if the residue type index
+		is used) followed by an index computation, and returns a lightweight
+		\link RotamerRange RotamerRange \endlink pointing into the table.
+		\par
+		Backbone-independent libraries are stored as a table with a single bin.
+		\par
+		After construction, the table is never modified by lookups, so one
+		instance can be shared by any number of threads.
+		\par
+		Since parsing the text libraries is slow, the table can be written to
+		and read from a binary cache file (see \link load load \endlink). The
+		cache consists of the magic string "BROT", a 32 bit version number, the
+		size and modification time of the library it was created from, and
+		the table data in native byte order.
+	*/
+	class BALL_EXPORT RotamerTable
+	{
+		public:
+
+		BALL_CREATE(RotamerTable)
+
+		/** @name Type definitions
+		*/
+		//@{
+		/** The rotamers of one residue type in one backbone bin.
+				The pointers remain valid as long as the table is not modified.
+		*/
+		struct BALL_EXPORT RotamerRange
+		{
+			/// the number of rotamers
+			Size size;
+			/// the number of side chain torsions of the residue type
+			Size number_of_torsions;
+			/// the rotamer probabilities
+			const float* probabilities;
+			/// the \f$\chi\f$ angles in degrees, four per rotamer
+			const float* chis;
+
+			/// Return the i-th rotamer as a Rotamer object
+			Rotamer getRotamer(Position i) const
+			{
+				const float* chi = chis + 4 * i;
+				return Rotamer(probabilities[i], chi[0], chi[1], chi[2], chi[3]);
+			}
+		};
+		//@}
+
+		/**	@name Constants
+		*/
+		//@{
+		/// The version of the binary cache format
+		static const Size CACHE_VERSION;
+		//@}
+
+		/**	@name	Constructors and Destructors
+		*/
+		//@{
+		///	Default constructor, creates an empty table
+		RotamerTable();
+
+		///	Create the table from a rotamer library
+		RotamerTable(const RotamerLibrary& library);
+
+		///	Copy constructor
+		RotamerTable(const RotamerTable& table);
+
+		///	Destructor
+		virtual ~RotamerTable();
+		//@}
+
+		/**	@name Assignment
+		*/
+		//@{
+		///	Assignment operator
+		RotamerTable& operator = (const RotamerTable& rhs);
+
+		/// Replace the contents by the rotamers of a library
+		void set(const RotamerLibrary& library);
+
+		/// Remove all rotamers
+		void clear();
+		//@}
+
+		/**	@name Binary cache
+		*/
+		//@{
+		/** Read the table from a binary cache file.
+				The table is not modified if the cache is invalid.
+				@param library_filename if not empty, the cache is only accepted if it was
+							 created from this library and the library has not changed since
+				@return false if the file is not a valid cache of the current version,
+								is truncated, or is stale
+				@throw Exception::FileNotFound if the file cannot be opened
+		*/
+		bool readCache(const String& filename, const String& library_filename = "");
+
+		/** Write the table to a binary cache file.
+				@param library_filename the library the table was created from, its size
+							 and modification time are stored to detect stale caches
+				@throw Exception::FileNotFound if the file cannot be created
+		*/
+		void writeCache(const String& filename, const String& library_filename = "") const;
+
+		/** Read a rotamer library, using a binary cache if possible.
+				If the cache file exists, is valid and was created from the current
+				version of the library, it is read. Otherwise the library
+				is parsed and the cache is (re)written. Errors writing the cache are
+				reported, but do not affect the table.
+				@param library_filename the rotamer library (searched in the data path)
+				@param cache_filename the binary cache
+				@param fragment_db the fragment db used for parsing the library
+				@return true if the table was read from the cache
+		*/
+		bool load(const String& library_filename, const String& cache_filename, const FragmentDB& fragment_db);
+		//@}
+
+		/**	@name Accessors
+		*/
+		//@{
+		/// Return true if the rotamers are backbone dependent
+		bool isBackboneDependent() const { return backbone_dependent_; }
+
+		/// Return the number of residue types
+		Size getNumberOfResidueTypes() const { return names_.size(); }
+
+		/// Return the total number of rotamers
+		Size getNumberOfRotamers() const { return probabilities_.size(); }
+
+		/// Return the number of bins per backbone torsion (1 for backbone-independent tables)
+		Size getNumberOfBins() const { return number_of_bins_; }
+
+		/// Return the index of the residue type with the given name, -1 if there is none
+		Index getResidueType(const String& name) const;
+
+		/// Return the name of a residue type
+		const String& getResidueName(Position type) const { return names_[type]; }
+
+		/// Return the number of side chain torsions of a residue type
+		Size getNumberOfTorsions(Position type) const { return number_of_torsions_[type]; }
+
+		/** Return the rotamers of a residue type for the given backbone torsions.
+				The torsions (in degrees) are ignored for backbone-independent tables.
+		*/
+		RotamerRange getRotamers(Position type, float phi = 0.0, float psi = 0.0) const;
+
+		/// Return the rotamers of the residue type with the given name, an empty range if there is none
+		RotamerRange getRotamers(const String& name, float phi = 0.0, float psi = 0.0) const;
+
+		/// Return the rotamers for a residue, using its backbone torsions if required
+		RotamerRange getRotamers(const Residue& residue) const;
+		//@}
+
+		protected:
+
+		/// Return the bin of a backbone torsion
+		Position getBin_(float angle) const;
+
+		/// flag which is true when the table has backbone dependent rotamers
+		bool backbone_dependent_;
+
+		/// the torsion of the first bin in degrees
+		Index min_angle_;
+
+		/// discretization step width of the torsion angles
+		Size step_width_;
+
+		/// the number of bins per torsion
+		Size number_of_bins_;
+
+		/// the residue type names
+		std::vector<String> names_;
+
+		/// the residue type indices
+		StringHashMap<Position> name_index_;
+
+		/// the number of torsions per residue type
+		std::vector<Size> number_of_torsions_;
+
+		/// first rotamer of each (type, phi bin, psi bin), plus the total number of rotamers
+		std::vector<Position> offsets_;
+
+		/// the probability of each rotamer
+		std::vector<float> probabilities_;
+
+		/// the chi angles of each rotamer
+		std::vector<float> chis_;
+	};
+
+} // namespace BALL
+
+#endif // BALL_STRUCTURE_ROTAMERTABLE_H
@@ -13,8 +13,19 @@
 # include <BALL/DATATYPE/options.h>
 #endif
 
+#ifndef BALL_STRUCTURE_RESIDUEROTAMERSET_H
+# include <BALL/STRUCTURE/residueRotamerSet.h>
+#endif
+
+#include <vector>
+
 namespace BALL 
 {
+	class RotamerLibrary;
+
+	template <typename Item>
+	class HashGrid3;
+
 	/**	Side Chain Placement Processor
 			\ingroup StructureMiscellaneous
 	*/
@@ -27,6 +38,21 @@ namespace BALL
 	 *  The option Option::MUTATE_SELECTED_SIDE_CHAINS can be used to mutate selected
 	 *  amino acids as specified in the member mutated_sequence_.
 	 *
+	 *  Alternatively, Method::ROTAMER_PACKING places the side chains without any
+	 *  external program. The rotamers of each residue are taken from the
+	 *  \link RotamerLibrary RotamerLibrary \endlink given in Option::ROTAMER_LIBRARY
+	 *  and scored by a soft steric repulsion plus the negative logarithm of the rotamer
+	 *  probability. Self energies (against the fixed backbone and all residues that are
+	 *  not placed) and pair energies are computed using a cell list, the pair energies
+	 *  in Option::N_THREADS threads. Rotamers that cannot be part of the optimal solution
+	 *  are removed by Goldstein dead-end elimination. The remaining interaction
+	 *  graph is solved exactly by variable elimination along a minimum fill-in order
+	 *  (see \link TreeWidth TreeWidth \endlink), i.e., by dynamic programming on its
+	 *  tree decomposition. If an intermediate table would exceed Option::MAX_TABLE_SIZE
+	 *  entries, a greedy iterative optimization is used instead.
+	 *  The native method requires bonds (see FragmentDB::BuildBondsProcessor) and does not
+	 *  support mutations. Cysteines in disulfide bonds are not placed.
+	 *
 	 *  <br> 
 	 *  Example code: <br> 	
 	 *  \code
@@ -92,7 +118,25 @@ namespace BALL
 				/** mutate and compute side chain positions for selected amino acids
 				 */
 				static const char* MUTATE_SELECTED_SIDE_CHAINS;
-				
+
+				/** the rotamer library used by Method::ROTAMER_PACKING
+				 */
+				static const char* ROTAMER_LIBRARY;
+
+				/** the weight of the rotamer probability term (-log(P / P_max))
+				 *  relative to the steric energy
+				 */
+				static const char* PROBABILITY_WEIGHT;
+
+				/** the maximum number of entries of a table created during
+				 *  variable elimination before falling back to greedy optimization
+				 */
+				static const char* MAX_TABLE_SIZE;
+
+				/** Number of parallel threads used for the energy computation.
+				 *  Parallelization via BOOST threads.
+				 */
+				static const char* N_THREADS;
 			};
 
 			/// Default values for options
@@ -104,6 +148,10 @@ namespace BALL
 				static const String SCWRL_INPUT_FILE;
 				static const String SCWRL_SEQUENCE_FILE;
 				static const String SCWRL_OUTPUT_FILE;
+				static const String ROTAMER_LIBRARY;
+				static const float  PROBABILITY_WEIGHT;
+				static const Size   MAX_TABLE_SIZE;
+				static const Size   N_THREADS;
 			};
 
 			struct BALL_EXPORT Method
@@ -112,6 +160,11 @@ namespace BALL
 				 * SCWRL4 is a program for predicting side-chain conformations for a given protein backbone.
 				 */
 				static const String SCWRL_4_0;
+
+				/**
+				 * In-process rotamer packing using dead-end elimination and tree decomposition.
+				 */
+				static const String ROTAMER_PACKING;
 				//static const String SCWRL_SERVER; 
 				//static const String ILP;
 			};
@@ -188,6 +241,19 @@ namespace BALL
 			 */
 			String getMutations() {return mutated_sequence_;}
 
+			/** Return the energy of the last Method::ROTAMER_PACKING placement.
+			 */
+			double getPackingEnergy() const {return packing_energy_;}
+
+			/** Return the number of residues placed by the last Method::ROTAMER_PACKING run.
+			 */
+			Size getNumberOfPackedResidues() const {return number_of_packed_residues_;}
+
+			/** Return the number of rotamers removed by dead-end elimination 
+			 *  in the last Method::ROTAMER_PACKING run.
+			 */
+			Size getNumberOfEliminatedRotamers() const {return number_of_eliminated_rotamers_;}
+
 			//@}
 			/** @name Assignment
 			*/
@@ -213,6 +279,81 @@ namespace BALL
 			 * @return bool - true otherwise
 			 */
 			bool readOptions_(); 
+
+			/// A residue whose side chain is placed by Method::ROTAMER_PACKING.
+			struct PackingResidue_
+			{
+				/// the residue
+				Residue* residue;
+				/// its rotamers, using the residue itself as template
+				ResidueRotamerSet rotamers;
+				/// the number of side chain heavy atoms
+				Size number_of_atoms;
+				/// side chain atom positions, number_of_atoms entries per rotamer
+				std::vector<Vector3> positions;
+				/// side chain atom radii
+				std::vector<float> radii;
+				/// center and radius of a sphere enclosing each rotamer
+				std::vector<Vector3> rotamer_centers;
+				std::vector<float> rotamer_extents;
+				/// energy of each rotamer with the fixed environment
+				std::vector<double> self_energies;
+				/// false for rotamers removed by dead-end elimination
+				std::vector<bool> alive;
+				/// indices of the pairs this residue takes part in
+				std::vector<Position> pairs;
+			};
+
+			/// Interaction energies between the rotamers of two residues.
+			struct PackingPair_
+			{
+				Position first;
+				Position second;
+				/// energies, row-major with the rotamers of first as rows
+				std::vector<double> energies;
+			};
+
+			/// Orders pairs lexicographically by their residue indices.
+			struct PairLess_
+			{
+				bool operator () (const PackingPair_& a, const PackingPair_& b) const
+				{
+					return (a.first < b.first) || ((a.first == b.first) && (a.second < b.second));
+				}
+			};
+
+			/// Place the side chains by Method::ROTAMER_PACKING.
+			void packSideChains_(AtomContainer& ac);
+
+			/// Collect the residues to be placed and compute their rotamer coordinates.
+			void setupPacking_(AtomContainer& ac, std::vector<Vector3>& environment, 
+			                   std::vector<float>& environment_radii, std::vector<const Residue*>& environment_owners);
+
+			/// Thread worker: self energies of every stride-th residue starting at first.
+			void computeSelfEnergies_(const HashGrid3<Position>* grid, const std::vector<Vector3>* environment,
+			                          const std::vector<float>* environment_radii, 
+			                          const std::vector<const Residue*>* environment_owners, Position first, Size stride);
+
+			/// Thread worker: energies of every stride-th pair starting at first.
+			void computePairEnergies_(Position first, Size stride);
+
+			/// Goldstein dead-end elimination, returns the number of removed rotamers.
+			Size eliminateDeadEnds_();
+
+			/// Find the minimum energy assignment of the remaining rotamers.
+			void solvePacking_(std::vector<Position>& assignment);
+
+			/// Greedy iterative optimization, used if variable elimination is too expensive.
+			void optimizeGreedily_(std::vector<Position>& assignment);
+
+			/// Return the energy of an assignment.
+			double computePackingEnergy_(const std::vector<Position>& assignment) const;
+
+			/// Return the energy between rotamer r of the pair's first residue and rotamer s of its second residue.
+			double getPairEnergy_(const PackingPair_& pair, Position r, Position s) const
+			{
+				return pair.energies[r * packing_residues_[pair.second].rotamers.getNumberOfRotamers() + s];
+			}
 		
 			/// Sequence in OneLetterCode with mutated residues.
 			String mutated_sequence_;	
@@ -220,6 +361,20 @@ namespace BALL
 			// The processor state. 
 			bool valid_;
 
+			/// The rotamer library used by Method::ROTAMER_PACKING
+			RotamerLibrary* rotamer_library_;
+
+			/// The residues placed by Method::ROTAMER_PACKING
+			std::vector<PackingResidue_> packing_residues_;
+
+			/// The interacting pairs of residues
+			std::vector<PackingPair_> packing_pairs_;
+
+			/// Statistics of the last Method::ROTAMER_PACKING run
+			double packing_energy_;
+			Size number_of_packed_residues_;
+			Size number_of_eliminated_rotamers_;
+
 	};
 
 } // namespace BALL 
@@ -125,6 +125,19 @@ namespace BALL
 
 		/// Get the surface type to be computed.
 		SurfaceType getType() const  { return surface_type_; }
+
+		/** Set the number of threads used for the triangulation of the SES.
+				Default is 1.
+		*/
+		void setNumberOfThreads(Size number_of_threads) { number_of_threads_ = std::max(number_of_threads, (Size)1); }
+
+		/// Get the number of threads used for the triangulation of the SES.
+		Size getNumberOfThreads() const { return number_of_threads_; }
+
+		/** Get the wall clock time (in seconds) of each phase of the last surface computation.
+				The phases of the SES triangulation are prefixed with "triangulation: ".
+		*/
+		const std::vector<std::pair<String, double> >& getTimings() const { return timings_; }
 		//@}
 
 		protected:
@@ -149,6 +162,12 @@ namespace BALL
 
 		//_
 		double													probe_radius_;
+
+		//_
+		Size														number_of_threads_;
+
+		//_
+		std::vector<std::pair<String, double> >	timings_;
 	};
 
 }
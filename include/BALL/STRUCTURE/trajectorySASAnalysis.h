@@ -0,0 +1,291 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#ifndef BALL_STRUCTURE_TRAJECTORYSASANALYSIS_H
+#define BALL_STRUCTURE_TRAJECTORYSASANALYSIS_H
+
+#ifndef BALL_COMMON_H
+#	include <BALL/common.h>
+#endif
+
+#ifndef BALL_DATATYPE_OPTIONS_H
+# include <BALL/DATATYPE/options.h>
+#endif
+
+#ifndef BALL_MATHS_VECTOR3_H
+#	include <BALL/MATHS/vector3.h>
+#endif
+
+#include <iosfwd>
+#include <vector>
+
+namespace BALL
+{
+	class AtomContainer;
+	class TrajectoryFile;
+
+	/**	Solvent accessible surface and volume analysis of trajectories.
+			This class computes numerical SAS areas and volumes for every frame of a
+			\link TrajectoryFile TrajectoryFile \endlink (e.g. DCDFile or TRRFile).
+			The topology (atom radii and residue membership) is extracted once from an
+			AtomContainer; afterwards, frames are streamed from the file into independent
+			coordinate buffers and processed by several threads concurrently. The
+			AtomContainer itself is never modified, so no copies of the System are required.
+			\par
+			The SAS kernel is the same double cubic lattice approach as used in
+			\link NumericalSAS NumericalSAS \endlink, but operates on flat coordinate
+			and radius arrays with a cell list for the neighbour search.
+			\par
+			Per frame, the total area and volume are stored in memory. Optionally, the
+			per-atom or per-residue values are written as a time series to a CSV or a
+			compact binary file. The binary format consists of the magic string "BSAS",
+			a 32 bit version number, the number of columns per frame (32 bit) and the
+			column labels (as zero-terminated strings) followed by one row of 32 bit floats
+			per frame (native byte order).
+			\par
+			Running averages over all frames per atom and per residue are available
+			after the analysis via \link getAverageAtomAreas getAverageAtomAreas \endlink
+			and \link getAverageResidueAreas getAverageResidueAreas \endlink.
+
+			\ingroup Surface
+	*/
+	class BALL_EXPORT TrajectorySASAnalysis
+	{
+		public:
+
+			/**	@name Constant Definitions
+			*/
+			//@{
+
+			/** Option names
+			 */
+			struct BALL_EXPORT Option
+			{
+				/** The radius of the spherical probe used for the SAS definition.
+				 */
+				static const String PROBE_RADIUS;
+
+				/** The number of point samples per sphere (lower limit, see NumericalSAS).
+				 */
+				static const String NUMBER_OF_POINTS;
+
+				/** This flag decides whether volumes will be computed as well (default = true).
+				 */
+				static const String COMPUTE_VOLUME;
+
+				/** If true, the time series output contains values per residue
+				 *  instead of values per atom (default = false).
+				 */
+				static const String PER_RESIDUE;
+
+				/** The format of the time series output, either "csv" or "binary".
+				 */
+				static const String OUTPUT_FORMAT;
+
+				/** Number of parallel threads to be used. Parallelization via BOOST threads.
+				 */
+				static const String N_THREADS;
+
+				/** Number of frames each thread processes per batch. Larger values
+				 *  increase memory consumption but reduce synchronization overhead.
+				 */
+				static const String FRAMES_PER_THREAD;
+			};
+
+			/** Default values for TrajectorySASAnalysis options.
+			 */
+			struct BALL_EXPORT Default
+			{
+				/// 1.5 \AA
+				static const float PROBE_RADIUS;
+				/// 400
+				static const Size NUMBER_OF_POINTS;
+				/// true
+				static const bool COMPUTE_VOLUME;
+				/// false
+				static const bool PER_RESIDUE;
+				/// "csv"
+				static const String OUTPUT_FORMAT;
+				/// 1
+				static const Size N_THREADS;
+				/// 4
+				static const Size FRAMES_PER_THREAD;
+			};
+
+			/** The result of the analysis of a single frame.
+			 *  The vectors are indexed by atom index resp. residue index as given
+			 *  by the order of the AtomContainer the analysis was set up with.
+			 */
+			struct BALL_EXPORT FrameResult
+			{
+				/// the total area of this frame
+				float total_area;
+				/// the total volume of this frame
+				float total_volume;
+				/// the area per atom
+				std::vector<float> atom_areas;
+				/// the volume per atom
+				std::vector<float> atom_volumes;
+				/// the area per residue
+				std::vector<float> residue_areas;
+				/// the volume per residue
+				std::vector<float> residue_volumes;
+			};
+
+			//@}
+			/** @name Constructors and Destructors. **/
+			//@{
+
+			BALL_CREATE(TrajectorySASAnalysis)
+
+			/** Default Constructor.
+			 */
+			TrajectorySASAnalysis();
+
+			/** Detailed Constructor.
+			 *  Calls \link setup setup \endlink for the given AtomContainer.
+			 */
+			TrajectorySASAnalysis(const AtomContainer& topology, const Options& options = Options());
+
+			/** Copy constructor.
+			 */
+			TrajectorySASAnalysis(const TrajectorySASAnalysis& analysis);
+
+			/** Destructor.
+			 */
+			virtual ~TrajectorySASAnalysis();
+			//@}
+
+			/** @name Setup and Analysis
+			 */
+			//@{
+
+			/** Extract radii and residue membership from the given AtomContainer.
+			 *  The atom order must correspond to the atom order of the snapshots
+			 *  (i.e., the order of an AtomIterator over the System that was
+			 *  used to write the trajectory).
+			 */
+			void setup(const AtomContainer& topology);
+
+			/** Analyse all (remaining) frames of a trajectory.
+			 *  The time series of total areas and volumes is stored in this instance,
+			 *  all other per-frame data is discarded after being accumulated into the averages.
+			 *  @param trajectory an opened trajectory file
+			 *  @return the number of frames processed
+			 *  @throw Exception::InvalidArgument if the number of atoms of the trajectory does not match the topology
+			 */
+			Size analyze(TrajectoryFile& trajectory);
+
+			/** Analyse all (remaining) frames of a trajectory and write the per-frame
+			 *  values to a file.
+			 *  The file format is determined by Option::OUTPUT_FORMAT.
+			 *  @param trajectory an opened trajectory file
+			 *  @param filename the name of the output file
+			 *  @return the number of frames processed
+			 *  @throw Exception::FileNotFound if the output file cannot be created
+			 *  @throw Exception::InvalidArgument if the number of atoms of the trajectory does not match the topology
+			 */
+			Size analyze(TrajectoryFile& trajectory, const String& filename);
+
+			/** Compute areas and volumes for a single set of coordinates.
+			 *  This method does not modify the instance and may be called
+			 *  concurrently from several threads.
+			 *  @param positions the atom positions in topology order
+			 *  @param result buffer for result delivery
+			 *  @throw Exception::InvalidArgument if the number of positions does not match the topology
+			 */
+			void computeFrame(const std::vector<Vector3>& positions, FrameResult& result) const;
+			//@}
+
+			/** @name Accessors
+			 */
+			//@{
+
+			/// Return the number of atoms of the topology
+			Size getNumberOfAtoms() const { return radii_.size(); }
+
+			/// Return the number of residues (fragments) of the topology
+			Size getNumberOfResidues() const { return residue_names_.size(); }
+
+			/// Return the number of frames analysed so far
+			Size getNumberOfFrames() const { return total_areas_.size(); }
+
+			/// Return the total area per frame
+			const std::vector<float>& getTotalAreas() const { return total_areas_; }
+
+			/// Return the total volume per frame
+			const std::vector<float>& getTotalVolumes() const { return total_volumes_; }
+
+			/// Return the area per atom averaged over all frames analysed so far
+			std::vector<float> getAverageAtomAreas() const;
+
+			/// Return the area per residue averaged over all frames analysed so far
+			std::vector<float> getAverageResidueAreas() const;
+
+			/// Return the residue labels (name and id) in output order
+			const std::vector<String>& getResidueNames() const { return residue_names_; }
+
+			/// Reset all accumulated results, but keep the topology
+			void clear();
+			//@}
+
+			/** Options.
+			 */
+			Options options;
+
+		protected:
+
+			//_ Set values from options.
+			void setDefaultOptions_();
+
+			//_ Precompute the unit sphere sample points
+			void computeSpherePoints_();
+
+			//_ Analyse all frames, optionally streaming to output
+			Size analyze_(TrajectoryFile& trajectory, std::ostream* output);
+
+			//_ Write the header of the time series
+			void writeHeader_(std::ostream& output) const;
+
+			//_ Write one frame of the time series
+			void writeFrame_(std::ostream& output, Size frame, const FrameResult& result) const;
+
+			//_ Add a frame to the running averages and the time series
+			void accumulate_(const FrameResult& result);
+
+			//_ Worker entry point: process every stride-th frame of the batch starting at first
+			void computeBatch_(const std::vector<std::vector<Vector3> >* frames, std::vector<FrameResult>* results,
+			                   Size first, Size last, Size stride) const;
+
+			//_ the SAS radii (atom radius + probe radius, 0 for ignored atoms)
+			std::vector<float> radii_;
+
+			//_ residue index for each atom, -1 if the atom has no parent fragment
+			std::vector<Index> atom_residue_;
+
+			//_ residue labels
+			std::vector<String> residue_names_;
+
+			//_ unit sphere sample points
+			std::vector<Vector3> sphere_points_;
+
+			//_ maximal SAS radius
+			float max_radius_;
+
+			//_ total area per frame
+			std::vector<float> total_areas_;
+
+			//_ total volume per frame
+			std::vector<float> total_volumes_;
+
+			//_ accumulated areas per atom
+			std::vector<double> atom_area_sums_;
+
+			//_ accumulated areas per residue
+			std::vector<double> residue_area_sums_;
+	};
+
+} // namespace BALL
+
+#endif // BALL_STRUCTURE_TRAJECTORYSASANALYSIS_H
@@ -125,6 +125,18 @@ namespace BALL
 		double getDensity() const
 			;
 
+		/** Set the number of threads used by triangulation.
+				The contact faces and the independent spheric faces are triangulated
+				concurrently if more than one thread is requested. Default is 1.
+		*/
+		void setNumberOfThreads(Size number_of_threads)
+			;
+
+		/** Get the number of threads used by triangulation.
+		*/
+		Size getNumberOfThreads() const
+			;
+
 		//@}
 
 		/** @name Accessors
@@ -134,6 +146,12 @@ namespace BALL
 		void compute()
 			throw(Exception::GeneralException,Exception::DivisionByZero);
 
+		/** Get the wall clock time (in seconds) spent in each phase of the last triangulation.
+				The phases are given in the order in which they were executed.
+		*/
+		const std::vector<std::pair<String, double> >& getTimings() const
+			;
+
 		//@}
 
 		protected:
@@ -146,6 +164,10 @@ namespace BALL
 
 		double density_;
 
+		Size number_of_threads_;
+
+		std::vector<std::pair<String, double> > timings_;
+
 		//@}
 
 	};
@@ -246,6 +268,27 @@ namespace BALL
 				 const TSphere3<double>& sphere)
 			;
 
+		void triangulateContactFace
+				(SESFace*									face,
+				 const TSphere3<double>&	sphere,
+				 TriangulatedSES&					part)
+			;
+
+		void triangulateFacesParallel
+				(const std::vector<SESFace*>&	faces,
+				 bool												contact,
+				 std::vector<bool>&						ok)
+			;
+
+		void triangulateFacesThread
+				(const std::vector<SESFace*>*				faces,
+				 bool															contact,
+				 std::vector<TriangulatedSES*>*		parts,
+				 Position													first,
+				 Size															stride,
+				 String*													error)
+			;
+
 		bool triangulateSphericFace
 				(SESFace* 			face,
 				 const TSphere3<double>&	sphere)
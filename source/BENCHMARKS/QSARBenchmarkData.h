@@ -0,0 +1,47 @@
+// -*- Mode: C++; tab-width: 2; -*-
+// vi: set ts=2:
+//
+
+#include <BALL/QSAR/QSARData.h>
+#include <BALL/SYSTEM/file.h>
+
+#include <cstdlib>
+#include <fstream>
+
+using namespace BALL;
+using namespace BALL::QSAR;
+
+/** Helper function: creates a centered data set of random descriptor values.
+		The response is the weighted sum of every step-th descriptor plus noise.
+		The data set is the same for each call with the same arguments.
+		This function is used by the benchmarks of the QSAR validation and feature selection.
+*/
+inline void createData(Size number_of_compounds, Size number_of_descriptors, Size step, QSARData& data)
+{
+	srand(4711);
+
+	String filename;
+	File::createTemporaryFilename(filename);
+
+	std::ofstream out(filename.c_str());
+	for (Position i = 0; i < number_of_compounds; ++i)
+	{
+		double response = 0;
+		for (Position j = 0; j < number_of_descriptors; ++j)
+		{
+			double value = (double)rand() / RAND_MAX;
+			if (j % step == 0)
+			{
+				response += value * (j + 1);
+			}
+			out << value << "\t";
+		}
+		out << response + (double)rand() / RAND_MAX << std::endl;
+	}
+	out.close();
+
+	data.readCSVFile(filename.c_str(), 1, 0, 0, "\t", 0, 0);
+	data.centerData(true);
+
+	File::remove(filename);
+}
@@ -8,6 +8,7 @@ SET(SOURCES_LIST
 	dockResultFile.C
 	CCP4File.C
 	CIFFile.C
+	BCTFile.C
 	DCDFile.C
 	DSN6File.C
 	GAMESSDatFile.C
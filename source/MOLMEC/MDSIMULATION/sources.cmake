@@ -5,7 +5,9 @@ SET(DIRECTORY source/MOLMEC/MDSIMULATION)
 SET(SOURCES_LIST
 	molecularDynamics.C
 	microCanonicalMD.C
-	canonicalMD.C 
+	canonicalMD.C
+	constraintSolver.C
+	multipleTimeStepMD.C
 )	
 
 ADD_BALL_SOURCES("MOLMEC/MDSIMULATION" "${SOURCES_LIST}")
@@ -5,6 +5,7 @@ SET(DIRECTORY source/QSAR)
 SET(SOURCES_LIST
 	aromaticityProcessor.C
 	automaticModelCreator.C
+	batchPredictor.C
 	bayesModel.C
 	classificationModel.C
 	classificationValidation.C
@@ -12,8 +13,11 @@ SET(SOURCES_LIST
 	connectivityBase.C
 	connectivityDescriptors.C
 	descriptor.C
+	descriptorPipeline.C
 	exception.C
+	incrementalCrossValidation.C
 	kernel.C
+	kernelEquation.C
 	kernelModel.C
 	latentVariableModel.C
 	linearModel.C
@@ -7,6 +7,7 @@ SET(SOURCES_LIST
 	assignBondOrderProcessor.C
 	atomBijection.C
 	atomTyper.C
+	batchRMSDMinimizer.C
 	binaryFingerprintMethods.C
 	bindingPocketProcessor.C
 	buildBondsProcessor.C
@@ -15,6 +16,7 @@ SET(SOURCES_LIST
 	defaultProcessors.C
 	disulfidBondProcessor.C
 	DNAMutator.C
+	fingerprintDatabase.C
 	fragmentDB.C
 	geometricProperties.C
 	geometricTransformations.C
@@ -28,6 +30,7 @@ SET(SOURCES_LIST
 	mutator.C
 	nucleotideMapping.C
 	numericalSAS.C
+	packedFingerprint.C
 	peptides.C
 	peptideBuilder.C
 	peptideCapProcessor.C
@@ -65,9 +68,11 @@ SET(SOURCES_LIST
 	triangulatedSAS.C
 	triangulatedSES.C
 	triangulatedSurface.C
+	trajectorySASAnalysis.C
 	UCK.C
 	residueRotamerSet.C
 	rotamerLibrary.C
+	rotamerTable.C
 	RMSDMinimizer.C
 )
 
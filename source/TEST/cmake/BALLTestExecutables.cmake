@@ -113,6 +113,7 @@ SET(BALL_DOCKING_TESTS
 	GeneticAlgorithm_test
 	GeneticIndividual_test
 	GridAnalysis_test
+	PairwiseRMSDMatrix_test
 	Parameter_test
 	PoseClustering_test
 	Receptor_test
@@ -216,6 +217,7 @@ SET(BALL_KERNEL_TESTS
 )
 
 SET(BALL_MOLMEC_TESTS
+	FlatVector_test
 	Gradient_test
 	AtomVector_test
 	MolmecSupport_test
@@ -229,8 +231,11 @@ SET(BALL_MOLMEC_TESTS
 	LineSearch_test
 	SteepestDescentMinimizer_test
 	ConjugateGradientMinimizer_test
+	BatchMinimizer_test
 	StrangLBFGSMinimizer_test
 	ShiftedLVMMMinimizer_test
+	ConstraintSolver_test
+	MultipleTimeStepMD_test
 	AtomTypes_test
 )
 
@@ -273,6 +278,7 @@ SET(BALL_FORMATS_TESTS
 	MOL2File_test
 	NMRStarFile_test
 	DCDFile_test
+	BCTFile_test
 	PDBRecords_test
 	PDBInfo_test
 	PDBFile_test
@@ -299,9 +305,12 @@ SET(BALL_STRUCTURE_TESTS
 	DisulfidBondProcessor_test
 	Enumerator_test
 	EnumeratorIndex_test
+	FingerprintDatabase_test
 	GeometricProperties_test
+	MolecularSimilarity_test
 	SimpleMolecularGraph_test
 	NumericalSAS_test
+	PackedFingerprint_test
 	PeptideBuilder_test
 	PeptideCapProcessor_test
 	Peptides_test
@@ -312,6 +321,7 @@ SET(BALL_STRUCTURE_TESTS
 	ReconstructFragmentProcessor_test
 	ResidueChecker_test
 	RMSDMinimizer_test
+	BatchRMSDMinimizer_test
 	SideChainPlacementProcessor_test
 	SmilesParser_test
 	SmartsParser_test
@@ -320,6 +330,7 @@ SET(BALL_STRUCTURE_TESTS
 	TransformationProcessor_test
 	TranslationProcessor_test
 	SurfaceProcessor_test
+	TrajectorySASAnalysis_test
 	SecondaryStructureProcessor_test
 	UCK_test
 	BuildBondsProcessor_test
@@ -328,6 +339,7 @@ SET(BALL_STRUCTURE_TESTS
 #	RingAnalyser_test
 	ResidueRotamerSet_test
 	RotamerLibrary_test
+	RotamerTable_test
 )
 
 IF(BALL_HAS_OPENBABEL)
@@ -378,6 +390,11 @@ SET(BALL_QSAR_TESTS
 	PLSModel_test
 	RRModel_test
 	SNBModel_test
+	QSARData_test
+	Validation_test
+	Kernel_test
+	BatchPredictor_test
+	IncrementalCrossValidation_test
 )
 
 SET(BALL_XDR_TESTS